@@ -0,0 +1,139 @@
+// Measure per-instruction cost of the execution loop (BaseCPU::SingleProcess), and the cost of
+// dispatching SingleExecutionStep through a virtual call (as BaseCPU did before it dispatched
+// statically to DERIVED_T).
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <ratio>
+
+#include "emp/math/Random.hpp"
+#include "emp/matching/MatchBin.hpp"
+
+#include "sgp/cpu/ToyCPU.hpp"
+#include "sgp/cpu/LinearFunctionsProgramCPU.hpp"
+#include "sgp/cpu/lfunprg/LinearFunctionsProgram.hpp"
+#include "sgp/cpu/mem/BasicMemoryModel.hpp"
+#include "sgp/inst/InstructionLibrary.hpp"
+#include "sgp/inst/lfpbm/InstructionAdder.hpp"
+#include "sgp/inst/lfpbm/inst_impls.hpp"
+
+/// ToyCPU variant whose SingleExecutionStep is virtual (and not final): stands in for hardware that
+/// pays an indirect call per instruction.
+class VirtualToyCPU : public sgp::cpu::BaseCPU<
+  VirtualToyCPU,
+  sgp::cpu::toy_cpu_impl::ExecState,
+  size_t,
+  sgp::cpu::DefaultCustomComponent
+> {
+public:
+  using this_t = VirtualToyCPU;
+  using exec_state_t = sgp::cpu::toy_cpu_impl::ExecState;
+  using base_hw_t = sgp::cpu::BaseCPU<this_t, exec_state_t, size_t, sgp::cpu::DefaultCustomComponent>;
+  using program_t = emp::vector<size_t>;
+  using tag_t = size_t;
+  using event_lib_t = typename base_hw_t::event_lib_t;
+  using thread_t = typename base_hw_t::Thread;
+
+protected:
+  program_t program;
+
+public:
+  VirtualToyCPU(event_lib_t& elib) : base_hw_t(elib) { }
+  virtual ~VirtualToyCPU() { }
+
+  void SetProgram(const program_t& p) { program = p; }
+
+  void ResetImpl() { program.clear(); }
+
+  emp::vector<size_t> FindModuleMatch(const tag_t& tag, size_t N) {
+    emp::vector<size_t> matches;
+    if (!program.size()) { return matches; }
+    for (size_t i = 0; i < N; ++i) matches.emplace_back((tag + i) % program.size());
+    return matches;
+  }
+
+  void InitThread(thread_t& thread, size_t module_id) {
+    thread.GetExecState().value = program[module_id];
+  }
+
+  virtual void SingleExecutionStep(this_t& hw, thread_t& thread) {
+    if (thread.GetExecState().value == 0) {
+      thread.SetDead();
+    } else {
+      thread.GetExecState().value -= 1;
+    }
+  }
+};
+
+/// Run num_threads never-ending toy threads for num_steps. Returns nanoseconds per instruction.
+template<typename HARDWARE_T>
+double RunToy(size_t num_threads, size_t num_steps) {
+  typename HARDWARE_T::event_lib_t event_lib;
+  HARDWARE_T hardware(event_lib);
+  hardware.SetActiveThreadLimit(num_threads);
+  hardware.SetProgram({std::numeric_limits<size_t>::max()});
+  for (size_t i = 0; i < num_threads; ++i) hardware.SpawnThreadWithID(0);
+  hardware.SingleProcess(); // Activate threads.
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t step = 0; step < num_steps; ++step) hardware.SingleProcess();
+  const auto stop = std::chrono::steady_clock::now();
+  const size_t num_insts = num_steps * hardware.GetNumActiveThreads();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / (double)num_insts;
+}
+
+/// Run num_threads LinearFunctionsProgramCPU threads (each in an infinite While loop) for
+/// num_steps. Returns nanoseconds per instruction.
+double RunLinearFunctions(size_t num_threads, size_t num_steps) {
+  using mem_model_t = sgp::cpu::mem::BasicMemoryModel;
+  using hardware_t = sgp::cpu::LinearFunctionsProgramCPU<
+    mem_model_t,
+    int,
+    emp::MatchBin<
+      size_t,
+      emp::HammingMetric<16>,
+      emp::RankedSelector<std::ratio<16+8, 16>>,
+      emp::AdditiveCountdownRegulator<>
+    >,
+    sgp::cpu::DefaultCustomComponent
+  >;
+  using inst_lib_t = typename hardware_t::inst_lib_t;
+  using event_lib_t = typename hardware_t::event_lib_t;
+  using program_t = typename hardware_t::program_t;
+
+  inst_lib_t inst_lib;
+  event_lib_t event_lib;
+  sgp::inst::lfpbm::InstructionAdder<hardware_t> inst_directory;
+  inst_directory.AddAllDefaultInstructions(inst_lib);
+  emp::Random random(1);
+  hardware_t hardware(random, inst_lib, event_lib);
+  hardware.SetActiveThreadLimit(num_threads);
+
+  program_t program;
+  program.PushInst(inst_lib, "SetMem", {0, 1, 0});
+  program.PushInst(inst_lib, "While", {0, 0, 0});
+  program.PushInst(inst_lib, "Inc", {1, 0, 0});
+  program.PushInst(inst_lib, "Add", {2, 1, 0});
+  program.PushInst(inst_lib, "Close", {0, 0, 0});
+  hardware.SetProgram(program);
+  for (size_t i = 0; i < num_threads; ++i) hardware.SpawnThreadWithID(0);
+  hardware.SingleProcess(); // Activate threads.
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t step = 0; step < num_steps; ++step) hardware.SingleProcess();
+  const auto stop = std::chrono::steady_clock::now();
+  const size_t num_insts = num_steps * hardware.GetNumActiveThreads();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / (double)num_insts;
+}
+
+int main() {
+  const size_t num_insts = 4000000;
+  std::cout << "threads, toy ns/inst, toy (virtual step) ns/inst, virtual overhead, lfp ns/inst" << std::endl;
+  for (size_t num_threads : {1, 16, 256}) {
+    const size_t num_steps = num_insts / num_threads;
+    const double toy_ns = RunToy<sgp::cpu::ToyCPU<>>(num_threads, num_steps);
+    const double virtual_ns = RunToy<VirtualToyCPU>(num_threads, num_steps);
+    const double lfp_ns = RunLinearFunctions(num_threads, num_steps / 4);
+    std::cout << num_threads << ", " << toy_ns << ", " << virtual_ns << ", "
+              << (virtual_ns / toy_ns) << ", " << lfp_ns << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,71 @@
+// Compare a population of hardware units with runtime thread capacities vs. fixed (compile-time,
+// inline) thread capacities (see sgp::cpu::sched::FixedCapacity).
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+#include "emp/math/Random.hpp"
+#include "emp/base/vector.hpp"
+
+#include "sgp/cpu/ToyCPU.hpp"
+
+constexpr size_t MAX_ACTIVE = 16;
+constexpr size_t THREAD_SPACE = 64;
+
+/// Build a population of hardware units, then step each unit (with a few spawns per step) for
+/// num_steps. Returns (ns per unit constructed, ns per unit step).
+template<typename HARDWARE_T>
+std::pair<double, double> RunPopulation(
+  const std::function<void(HARDWARE_T&)>& configure,
+  size_t pop_size,
+  size_t num_steps
+) {
+  typename HARDWARE_T::event_lib_t event_lib;
+  emp::Random random(1);
+  emp::vector<size_t> modules(4 * pop_size);
+  for (size_t& module : modules) module = random.GetUInt(8);
+  emp::vector<HARDWARE_T> population;
+  population.reserve(pop_size);
+  const auto build_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < pop_size; ++i) {
+    population.emplace_back(event_lib);
+    configure(population.back());
+  }
+  const auto build_stop = std::chrono::steady_clock::now();
+  for (HARDWARE_T& hw : population) hw.SetProgram({1, 2, 3, 5, 8, 13, 21, 34});
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t step = 0; step < num_steps; ++step) {
+    for (size_t i = 0; i < pop_size; ++i) {
+      HARDWARE_T& hw = population[i];
+      hw.SpawnThreadWithID(modules[(4 * i + step) % modules.size()]);
+      hw.SpawnThreadWithID(modules[(4 * i + step + 1) % modules.size()]);
+      hw.SingleProcess();
+    }
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return {
+    std::chrono::duration<double, std::nano>(build_stop - build_start).count() / (double)pop_size,
+    std::chrono::duration<double, std::nano>(stop - start).count() / (double)(pop_size * num_steps)
+  };
+}
+
+int main() {
+  using dynamic_t = sgp::cpu::ToyCPU<>;
+  using fixed_t = sgp::cpu::ToyCPU<
+    sgp::cpu::DefaultCustomComponent,
+    sgp::cpu::sched::FixedCapacity<MAX_ACTIVE, THREAD_SPACE>
+  >;
+  std::cout << "population, dynamic ns/build, fixed ns/build, dynamic ns/step, fixed ns/step, step speedup" << std::endl;
+  for (size_t pop_size : {1000, 10000, 100000}) {
+    const size_t num_steps = 1000000 / pop_size;
+    const auto dynamic_ns = RunPopulation<dynamic_t>(
+      [](dynamic_t& hw) { hw.SetActiveThreadLimit(MAX_ACTIVE); hw.SetThreadCapacity(THREAD_SPACE); },
+      pop_size, num_steps
+    );
+    const auto fixed_ns = RunPopulation<fixed_t>([](fixed_t&) { ; }, pop_size, num_steps);
+    std::cout << pop_size << ", " << dynamic_ns.first << ", " << fixed_ns.first << ", "
+              << dynamic_ns.second << ", " << fixed_ns.second << ", "
+              << (dynamic_ns.second / fixed_ns.second) << std::endl;
+  }
+  return 0;
+}
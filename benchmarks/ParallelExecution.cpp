@@ -0,0 +1,77 @@
+// Measure LinearProgramCPU throughput with many active threads, executed serially vs. across a
+// worker pool (see BaseCPU::SetParallelExecution).
+#include <chrono>
+#include <iostream>
+#include <ratio>
+
+#include "emp/math/Random.hpp"
+#include "emp/matching/MatchBin.hpp"
+
+#include "sgp/cpu/LinearProgramCPU.hpp"
+#include "sgp/cpu/mem/BasicMemoryModel.hpp"
+#include "sgp/inst/lpbm/InstructionAdder.hpp"
+#include "sgp/inst/lpbm/inst_impls.hpp"
+
+using mem_model_t = sgp::cpu::mem::BasicMemoryModel;
+using hardware_t = sgp::cpu::LinearProgramCPU<
+  mem_model_t,
+  int,
+  emp::MatchBin<
+    size_t,
+    emp::HammingMetric<16>,
+    emp::RankedSelector<std::ratio<16+8, 16>>,
+    emp::AdditiveCountdownRegulator<>
+  >
+>;
+
+constexpr size_t NUM_THREADS = 64;
+constexpr size_t QUANTUM = 256;
+constexpr size_t NUM_STEPS = 200;
+
+/// Run NUM_THREADS threads (each executing a long, mostly thread-local module) for NUM_STEPS
+/// SingleProcess calls, with the given number of workers. Returns ns per thread execution step.
+double RunHardware(typename hardware_t::inst_lib_t& inst_lib, size_t num_workers) {
+  typename hardware_t::event_lib_t event_lib;
+  emp::Random random(1);
+  hardware_t hw(random, inst_lib, event_lib);
+  hw.SetActiveThreadLimit(NUM_THREADS);
+  hw.SetThreadQuantum(QUANTUM);
+  hw.SetParallelExecution(num_workers);
+
+  typename hardware_t::program_t program;
+  program.PushInst(inst_lib, "ModuleDef", {0, 0, 0}, {typename hardware_t::tag_t()});
+  for (size_t i = 0; i < 512; ++i) {
+    program.PushInst(inst_lib, "Inc", {0, 0, 0});
+    program.PushInst(inst_lib, "Add", {1, 0, 1});
+    program.PushInst(inst_lib, "Mult", {2, 1, 0});
+    if (i % 64 == 63) program.PushInst(inst_lib, "WorkingToGlobal", {(int)(i % 4), 2, 0});
+  }
+  hw.SetProgram(program);
+
+  size_t num_exec_steps = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t step = 0; step < NUM_STEPS; ++step) {
+    while (hw.GetNumActiveThreads() + hw.GetNumPendingThreads() < NUM_THREADS) {
+      hw.SpawnThreadWithID(0);
+    }
+    hw.SingleProcess();
+    num_exec_steps += NUM_THREADS * QUANTUM;
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / (double)num_exec_steps;
+}
+
+int main() {
+  typename hardware_t::inst_lib_t inst_lib;
+  sgp::inst::lpbm::InstructionAdder<hardware_t> inst_adder;
+  inst_adder.AddAllDefaultInstructions(inst_lib);
+
+  const double serial_ns = RunHardware(inst_lib, 1);
+  std::cout << "workers, ns/thread step, speedup" << std::endl;
+  std::cout << 1 << ", " << serial_ns << ", " << 1.0 << std::endl;
+  for (size_t num_workers : {2, 4, 8}) {
+    const double parallel_ns = RunHardware(inst_lib, num_workers);
+    std::cout << num_workers << ", " << parallel_ns << ", " << (serial_ns / parallel_ns) << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,63 @@
+// Compare thread scheduling throughput with double priorities (heaps) vs. priority levels (buckets).
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "emp/math/Random.hpp"
+#include "emp/base/vector.hpp"
+
+#include "sgp/cpu/ToyCPU.hpp"
+
+using signalgp_t = sgp::cpu::ToyCPU<>;
+using event_lib_t = typename signalgp_t::event_lib_t;
+
+/// Run a spawn storm (more spawn requests than thread space every step, at priorities drawn from
+/// num_levels integer levels). Returns average nanoseconds per SingleProcess.
+double RunStorm(
+  size_t num_priority_levels,
+  size_t max_active,
+  size_t thread_space,
+  size_t num_levels,
+  size_t spawns_per_step,
+  size_t num_steps
+) {
+  event_lib_t event_lib;
+  emp::Random random(1);
+  signalgp_t hardware(event_lib);
+  hardware.SetActiveThreadLimit(max_active);
+  hardware.SetThreadCapacity(thread_space);
+  hardware.SetNumPriorityLevels(num_priority_levels);
+  hardware.SetProgram({1, 2, 3, 5, 8, 13, 21, 34});
+  // Pre-draw spawn requests so that random number generation is not timed.
+  emp::vector<size_t> modules(spawns_per_step * num_steps);
+  emp::vector<double> priorities(spawns_per_step * num_steps);
+  for (size_t i = 0; i < modules.size(); ++i) {
+    modules[i] = random.GetUInt(8);
+    priorities[i] = (double)random.GetUInt(num_levels);
+  }
+  size_t req = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t step = 0; step < num_steps; ++step) {
+    for (size_t i = 0; i < spawns_per_step; ++i, ++req) {
+      hardware.SpawnThreadWithID(modules[req], priorities[req]);
+    }
+    hardware.SingleProcess();
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / (double)num_steps;
+}
+
+int main() {
+  const size_t num_levels = 8;
+  const size_t num_steps = 20000;
+  std::cout << "max_active, thread_space, spawns/step, heap ns/step, bucket ns/step, speedup" << std::endl;
+  for (size_t max_active : {16, 64, 256, 1024}) {
+    const size_t thread_space = 4 * max_active;
+    const size_t spawns = 2 * max_active;
+    const double heap_ns = RunStorm(0, max_active, thread_space, num_levels, spawns, num_steps / (max_active / 16));
+    const double bucket_ns = RunStorm(num_levels, max_active, thread_space, num_levels, spawns, num_steps / (max_active / 16));
+    std::cout << max_active << ", " << thread_space << ", " << spawns << ", "
+              << heap_ns << ", " << bucket_ns << ", " << (heap_ns / bucket_ns) << std::endl;
+  }
+  return 0;
+}
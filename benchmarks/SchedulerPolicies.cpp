@@ -0,0 +1,72 @@
+// Compare thread scheduling throughput with the runtime-configurable scheduler vs. the equivalent
+// compile-time scheduler policies (see sgp/cpu/sched/SchedulerPolicies.hpp).
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+#include "emp/math/Random.hpp"
+#include "emp/base/vector.hpp"
+
+#include "sgp/cpu/ToyCPU.hpp"
+
+/// Run a spawn storm (more spawn requests than thread space every step) of short-lived threads.
+/// Returns average nanoseconds per SingleProcess.
+template<typename HARDWARE_T>
+double RunStorm(
+  const std::function<void(HARDWARE_T&)>& configure,
+  size_t max_active,
+  size_t spawns_per_step,
+  size_t num_steps
+) {
+  typename HARDWARE_T::event_lib_t event_lib;
+  emp::Random random(1);
+  HARDWARE_T hardware(event_lib);
+  configure(hardware);
+  hardware.SetActiveThreadLimit(max_active);
+  hardware.SetThreadCapacity(4 * max_active);
+  hardware.SetProgram({1, 2, 3, 5, 8, 13, 21, 34});
+  // Pre-draw spawn requests so that random number generation is not timed.
+  emp::vector<size_t> modules(spawns_per_step * num_steps);
+  emp::vector<double> priorities(spawns_per_step * num_steps);
+  for (size_t i = 0; i < modules.size(); ++i) {
+    modules[i] = random.GetUInt(8);
+    priorities[i] = (double)random.GetUInt(8);
+  }
+  size_t req = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t step = 0; step < num_steps; ++step) {
+    for (size_t i = 0; i < spawns_per_step; ++i, ++req) {
+      hardware.SpawnThreadWithID(modules[req], priorities[req]);
+    }
+    hardware.SingleProcess();
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / (double)num_steps;
+}
+
+int main() {
+  using configurable_t = sgp::cpu::ToyCPU<>;
+  using fifo_t = sgp::cpu::ToyCPU<sgp::cpu::DefaultCustomComponent, sgp::cpu::sched::FIFOScheduler>;
+  using priority_t = sgp::cpu::ToyCPU<sgp::cpu::DefaultCustomComponent, sgp::cpu::sched::PriorityPreemptiveScheduler<>>;
+  using round_robin_t = sgp::cpu::ToyCPU<sgp::cpu::DefaultCustomComponent, sgp::cpu::sched::RoundRobinScheduler<4>>;
+  const size_t num_steps = 20000;
+  std::cout << "max_active, policy, configurable ns/step, policy ns/step, speedup" << std::endl;
+  for (size_t max_active : {16, 64, 256}) {
+    const size_t spawns = 2 * max_active;
+    const size_t steps = num_steps / (max_active / 16);
+    const double config_fifo_ns = RunStorm<configurable_t>(
+      [](configurable_t& hw) { hw.SetThreadPriorityUse(false); }, max_active, spawns, steps
+    );
+    const double fifo_ns = RunStorm<fifo_t>([](fifo_t&) { ; }, max_active, spawns, steps);
+    const double config_priority_ns = RunStorm<configurable_t>([](configurable_t&) { ; }, max_active, spawns, steps);
+    const double priority_ns = RunStorm<priority_t>([](priority_t&) { ; }, max_active, spawns, steps);
+    const double config_rr_ns = RunStorm<configurable_t>(
+      [](configurable_t& hw) { hw.SetThreadPriorityUse(false); hw.SetThreadQuantum(4); }, max_active, spawns, steps
+    );
+    const double rr_ns = RunStorm<round_robin_t>([](round_robin_t&) { ; }, max_active, spawns, steps);
+    std::cout << max_active << ", FIFO, " << config_fifo_ns << ", " << fifo_ns << ", " << (config_fifo_ns / fifo_ns) << std::endl;
+    std::cout << max_active << ", PriorityPreemptive, " << config_priority_ns << ", " << priority_ns << ", " << (config_priority_ns / priority_ns) << std::endl;
+    std::cout << max_active << ", RoundRobin<4>, " << config_rr_ns << ", " << rr_ns << ", " << (config_rr_ns / rr_ns) << std::endl;
+  }
+  return 0;
+}
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <utility>
 #include <limits>
 #include <optional>
 #include <queue>
 #include <tuple>
+#include <type_traits>
 #include <memory>
 
 #include "emp/base/Ptr.hpp"
@@ -15,6 +17,21 @@
 #include "emp/datastructs/vector_utils.hpp"
 
 #include "../EventLibrary.hpp"
+#include "../utils/hash_utils.hpp"
+#include "sched/CycleDetector.hpp"
+#include "sched/DenseIDSet.hpp"
+#include "sched/IndexedHeap.hpp"
+#include "sched/PriorityBuckets.hpp"
+#include "sched/ProcessBudget.hpp"
+#include "sched/RingBuffer.hpp"
+#include "sched/RunList.hpp"
+#include "sched/SchedulerPolicies.hpp"
+#include "sched/SpawnResult.hpp"
+#include "sched/ThreadMembership.hpp"
+#include "sched/ThreadTable.hpp"
+#include "sched/TimingWheel.hpp"
+#include "sched/WaitLists.hpp"
+#include "sched/WorkerPool.hpp"
 
 // @discussion - where should I put configurable lambdas?
 // todo - move function implementations outside of class
@@ -37,6 +54,8 @@ struct DefaultCustomComponent { };
 ///   * TAG_T - Specifies the type that is used to search for modules when spawning a new thread.
 ///   * CUSTOM_COMPONENT_T - Optional template parameter. Specifies type of custom hardware component
 ///     to be added on to the SignalGP virtual hardware.
+///   * SCHEDULER_T - Optional template parameter. Specifies the thread scheduler policy (see
+///     sched/SchedulerPolicies.hpp). By default, scheduling is configured at runtime.
 ///
 /// SignalGP implementations that inherit from SignalGPBase add functionality to SignalGPBase's.
 /// At a high level, while SignalGPBase manages events and threads, derived implementations of SignalGP
@@ -44,7 +63,9 @@ struct DefaultCustomComponent { };
 /// information is required to specify the state of a thread? et cetera).
 ///
 /// REQUIREMENTS
-///   * Derived implementations MUST minimally specify the following methods:
+///   * Derived implementations MUST minimally specify the following methods (BaseCPU calls them
+///     statically, via GetHardware(); none of them are virtual). DERIVED_T may declare them
+///     non-public if it befriends BaseCPU. Missing methods are reported at compile time.
 ///     * ResetImpl()
 ///       - Return type: void
 ///       - Reset state information in DERIVED_T virtual hardware.
@@ -55,24 +76,49 @@ struct DefaultCustomComponent { };
 ///     * FindModuleMatch(const tag_t & tag, size_t n)
 ///       - Return type: vector<size_t>
 ///       - Find and return up to n module IDs that match with the given TAG_T tag.
+///     * FindModuleMatch(const tag_t & tag, size_t n, emp::vector<size_t> & matches) (OPTIONAL)
+///       - Return type: void
+///       - Same as above, but write matching module IDs into matches (cleared first). If provided,
+///         BaseCPU uses it for all tag-based spawns (see FindModuleMatches), so that spawning
+///         does not allocate; otherwise, each tag-based spawn allocates the vector returned by
+///         FindModuleMatch(tag, n).
 ///     * InitThread(thread_t & thread, size_t module_id)
 ///       - Return type: void
 ///       - Initialize thread_t thread with given module_id.
+///       - NOTE: InitThread is deferred until a spawned thread is activated (or accessed via
+///         GetThread), and is never called for pending threads that are killed before activation.
+///     * IsThreadLocalStep(thread_t & thread) (OPTIONAL; required to use SetParallelExecution)
+///       - Return type: bool
+///       - Would the thread's next execution step only read/write the thread's own state (and
+///         hardware state that does not change during execution)? Must be safe to call
+///         concurrently.
+///     * snapshot_t, SaveState(snapshot_t & snapshot) const, RestoreState(const snapshot_t & snapshot)
+///       (OPTIONAL; see Snapshot and Restore)
+///       - snapshot_t: type of saved hardware state; must derive from BaseState.
+///       - SaveState/RestoreState (Return type: void): save/restore DERIVED_T's state (BaseCPU's
+///         part of the snapshot is handled by BaseCPU).
+///     * HashState() const, HashExecState(const exec_state_t & state) const
+///       (OPTIONAL; required to use cycle detection; see SetCycleDetection)
+///       - Return type: size_t
+///       - HashState: hash of hardware-wide state that affects execution (e.g., global memory).
+///       - HashExecState: hash of the given execution state.
+///   * TIP: mark DERIVED_T as final.
 ///   * EXEC_STATE_T
 ///     * EXEC_STATE_T::Reset()
 ///       - Return type: void
 ///       - Reset the EXEC_STATE_T execution state.
+///     * EXEC_STATE_T::Recycle() (OPTIONAL; required to use SetExecStateRecycling)
+///       - Return type: void
+///       - Reset the EXEC_STATE_T execution state, keeping allocated storage for reuse.
 template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T=DefaultCustomComponent
+  typename CUSTOM_COMPONENT_T=DefaultCustomComponent,
+  typename SCHEDULER_T=sched::ConfigurableScheduler
 >
 class BaseCPU {
 public:
-  // Forward declarations
-  struct Thread;
-
   // Types that base signalgp functionality needs to know about.
   using hardware_t = DERIVED_T;
   using exec_state_t = EXEC_STATE_T;
@@ -81,62 +127,48 @@ public:
   using event_t = BaseEvent;
   using event_lib_t = EventLibrary<hardware_t>;
   using module_id_t = size_t;
+  using scheduler_t = SCHEDULER_T;
+  /// Fixed thread capacity (see sched::FixedCapacity); 0 if thread capacity is set at runtime.
+  static constexpr size_t FIXED_THREAD_SPACE = scheduler_t::THREAD_SPACE;
+  static constexpr bool FIXED_CAPACITY = FIXED_THREAD_SPACE > 0;
+  using thread_table_t = sched::ThreadTable<exec_state_t, FIXED_THREAD_SPACE>;
+  /// Thread handle (see sched::ThreadTable::Thread). Handles are cheap to copy, and a handle stays
+  /// valid for as long as its thread id is valid.
+  using Thread = typename thread_table_t::Thread;
   using thread_t = Thread;
+  using thread_state_t = sched::ThreadState;
   using fun_print_hardware_state_t = std::function<void(const hardware_t&, std::ostream &)>;
   using fun_print_execution_state_t = std::function<void(const exec_state_t &, const hardware_t&, std::ostream&)>;
   using fun_print_event_t = std::function<void(const event_t&, const hardware_t&, std::ostream&)>;
-
-  /// Thread state information.
-  struct Thread {
-    enum class ThreadState { RUNNING, DEAD, PENDING };
-    exec_state_t exec_state;  ///< Internal state information required by DERIVED_T to execute the thread.
-    double priority;          ///< Thread priority. Low priority threads are killed if higher priority threads are pending.
-    ThreadState run_state;    ///< Is this thread RUNNING, DEAD, or PENDING?
-
-    Thread(
-      const exec_state_t& _exec_state=exec_state_t(),
-      double _priority=1.0
-    ) :
-      exec_state(_exec_state),
-      priority(_priority),
-      run_state(ThreadState::DEAD)
-    { ; }
-
-    /// Reset thread to default state (priority = 1, DEAD). Calls EXEC_STATE_T::Reset().
-    void Reset() {
-      // @discussion - How do we want to handle this?
-      exec_state.Reset(); // TODO - make this functionality more flexible! Currently assumes exec_state_t has a Clear function!
-      run_state = ThreadState::DEAD;
-      priority = 1.0;
-    }
-
-    exec_state_t& GetExecState() { return exec_state; }
-    const exec_state_t& GetExecState() const { return exec_state; }
-
-    /// Set thread state to DEAD.
-    void SetDead() { run_state = ThreadState::DEAD; }
-
-    /// Is this thread dead?
-    bool IsDead() const { return run_state == ThreadState::DEAD; }
-
-    /// Set thread state to PENDING.
-    void SetPending() { run_state = ThreadState::PENDING; }
-
-    /// Is this thread PENDING?
-    bool IsPending() const { return run_state == ThreadState::PENDING; }
-
-    /// Set thread state to RUNNING.
-    void SetRunning() { run_state = ThreadState::RUNNING; }
-
-    /// Is this thread RUNNING?
-    bool IsRunning() const { return run_state == ThreadState::RUNNING; }
-
-    /// Retrieve this thread's priority level.
-    double GetPriority() const { return priority; }
-
-    /// Set thread priority.
-    void SetPriority(double p) { priority = p; }
-  };
+  using priority_key_t = std::tuple<double, size_t>; ///< (priority, thread id); thread id breaks ties.
+  using spawn_result_t = sched::SpawnResult;
+  using spawn_status_t = sched::SpawnStatus;
+  using process_budget_t = sched::ProcessBudget;
+  using process_result_t = sched::ProcessResult;
+  // Thread bookkeeping structures (stored inline with a fixed thread capacity).
+  using active_set_t = sched::BasicDenseIDSet<FIXED_THREAD_SPACE>;
+  using run_list_t = sched::BasicRunList<FIXED_THREAD_SPACE>;
+  using id_list_t = sched::Storage<size_t, FIXED_THREAD_SPACE>;
+  using pending_queue_t = sched::RingBuffer<size_t, FIXED_THREAD_SPACE>;
+  using wait_lists_t = sched::BasicWaitLists<FIXED_THREAD_SPACE>;
+  using membership_t = sched::Membership;
+  struct BaseState;
+
+  /// Wait keys for tag-based waits (see BlockThreadOnTag) have this bit set, so they never collide
+  /// with event ids (the wait keys of event-based waits).
+  static constexpr size_t TAG_WAIT_KEY_FLAG = ~(std::numeric_limits<size_t>::max() >> 1);
+
+  /// Are scheduler settings (thread priority use, quantum, etc.) configurable at runtime, or fixed
+  /// by the scheduler policy?
+  static constexpr bool SCHED_CONFIGURABLE = scheduler_t::CONFIGURABLE;
+  /// Are pending and active threads indexed by priority? (Always, with a configurable policy, since
+  /// thread priority use can be turned on at any time.)
+  static constexpr bool SCHED_INDEXES_PRIORITY = SCHED_CONFIGURABLE || scheduler_t::USE_PRIORITY;
+  static_assert(scheduler_t::QUANTUM > 0, "Scheduler quantum must be > 0.");
+  static_assert(scheduler_t::NUM_PRIORITY_LEVELS <= sched::PriorityBuckets::MAX_LEVELS,
+    "Too many priority levels.");
+  static_assert((scheduler_t::MAX_ACTIVE_THREADS == 0) == (scheduler_t::THREAD_SPACE == 0),
+    "Fixed capacity requires both a fixed active thread limit and a fixed thread space.");
 
 private:
 
@@ -150,28 +182,88 @@ private:
   } cur_thread;                       ///< Should always point to currently executing thread.
 
   bool is_executing=false;            ///< Is this hardware unit currently executing (within a SingleProcess)? Note that threads are executed inside SingleProcess.
+  size_t thread_change_cnt=0;         ///< Number of threads spawned or killed (by other threads) during execution; used to detect yields.
+  size_t num_instructions=0;          ///< Number of thread execution steps taken (since the last hardware reset).
+  bool step_in_progress=false;        ///< Was the current step paused partway through (see ProcessFor)?
+  size_t resume_thread_id=sched::RunList::npos; ///< Next thread to take its turn when a paused step resumes.
+  bool is_halted=false;               ///< Was the hardware halted on a state cycle (see SetHaltOnCycle)?
 
 protected:
   // -- Event management --
   event_lib_t& event_lib;                           ///< Library of events that hardware can handle.
-  std::deque<std::shared_ptr<event_t>> event_queue;  ///< Queue of events to be processed every time step.
+  sched::RingBuffer<std::shared_ptr<event_t>> event_queue;  ///< Queue of events to be processed every time step.
+  sched::TimingWheel<std::shared_ptr<event_t>> event_wheel; ///< Events scheduled for a future step (time = number of SingleProcess calls).
 
   // -- Thread management --
   // WARNING: Derived classes can modify these member variables AT THEIR OWN RISK!
   // Modifying thread management members in derived class may have unintended side effects. Use caution.
-  size_t max_active_threads=64;         ///< Maximum number of concurrently running (active) threads.
-  size_t max_thread_space=512;          ///< Maximum total active + pending threads.
-  bool use_thread_priority=true;        ///< Should SignalGP use thread priority when spawning/killing threads?
-  emp::vector<thread_t> threads;        /**< All threads (each could be active/inactive/pending).
+  size_t max_active_threads=FIXED_CAPACITY ? scheduler_t::MAX_ACTIVE_THREADS : 64; ///< Maximum number of concurrently running (active) threads.
+  size_t max_thread_space=FIXED_CAPACITY ? FIXED_THREAD_SPACE : 512;              ///< Maximum total active + pending threads.
+  bool use_thread_priority=scheduler_t::USE_PRIORITY; ///< Should SignalGP use thread priority when spawning/killing threads?
+  bool use_spawn_admission_control=false; ///< Should spawn requests that cannot win an active slot be rejected up front?
+  size_t thread_quantum=scheduler_t::QUANTUM;  ///< Maximum number of execution steps each thread gets per SingleProcess.
+  bool yield_on_thread_change=false;    ///< Should a thread yield the rest of its quantum after spawning/killing a thread?
+  bool use_fair_share=false;            ///< Should threads get execution steps in proportion to their priority (see SetFairShareScheduling)?
+  size_t fair_share_max_quantum=64;     ///< Maximum number of execution steps per thread per SingleProcess in fair-share mode.
+  size_t max_spawn_latency=0;           ///< Longest observed time (in steps) from a thread's spawn to its first execution step.
+  thread_table_t threads;               /**< All threads (each could be active/inactive/pending).
                                           *   Initially threads.size = MIN(2*max_active_threads, max_thread_space),
-                                          *   but vector will grow as necessary up to max_thread_space.
-                                          *   NOTE that we can't track threads by priority because
-                                          *   thread priorities can be altered on the fly.
+                                          *   but table will grow as necessary up to max_thread_space.
+                                          *   Scheduler metadata (run state, priority, ...) is stored
+                                          *   apart from execution states (see sched::ThreadTable).
                                           **/
-  emp::vector<size_t> thread_exec_order;      ///< Thread execution order (not all guaranteed to be in RUNNING state).
-  std::unordered_set<size_t> active_threads;  ///< Active thread ids, all currently running.
-  emp::vector<size_t> unused_threads;         ///< Pool of unused thread ids.
-  std::deque<size_t> pending_threads;         ///< Pending (for consideration to be shifted to ACTIVE) thread ids.
+  /// Thread execution order: active thread ids, in order of activation (not all guaranteed to be
+  /// in RUNNING state; threads killed or blocked mid-execution are removed when next visited).
+  run_list_t thread_exec_order;
+  mutable emp::vector<size_t> thread_exec_order_cache;  ///< Contents of thread_exec_order (see GetThreadExecOrder).
+  mutable size_t thread_exec_order_cache_version=(size_t)-1; ///< thread_exec_order version when cached.
+  active_set_t active_threads;     ///< Active thread ids, all currently running.
+  id_list_t unused_threads;        ///< Pool of unused thread ids.
+  pending_queue_t pending_threads; ///< Pending (for consideration to be shifted to ACTIVE) thread ids.
+  /// Blocked thread ids, by wait key. Once parked (see SingleProcess), blocked threads are neither
+  /// active, pending, nor unused, and they are not in the execution order.
+  wait_lists_t blocked_threads;
+  /// Woken parked thread ids, in the order they were woken, waiting for an active slot (see
+  /// WakeThread). They are resumed before any pending thread is activated.
+  pending_queue_t woken_threads;
+  // Thread priority heaps (keyed on priority_key_t), kept up to date as threads are spawned,
+  // activated, killed, and re-prioritized.
+  sched::IndexedHeap<priority_key_t, std::less<priority_key_t>, FIXED_THREAD_SPACE> pending_priorities_MAX;    ///< Pending threads, highest priority on top.
+  sched::IndexedHeap<priority_key_t, std::greater<priority_key_t>, FIXED_THREAD_SPACE> pending_priorities_MIN; ///< Pending threads, lowest priority on top.
+  sched::IndexedHeap<priority_key_t, std::greater<priority_key_t>, FIXED_THREAD_SPACE> active_priorities_MIN;  ///< Active threads, lowest priority on top.
+  // Priority-bucket scheduler mode (opt-in; see SetNumPriorityLevels): instead of the heaps above,
+  // threads are tracked at integer priority levels.
+  size_t num_priority_levels=scheduler_t::NUM_PRIORITY_LEVELS; ///< Number of integer priority levels (0 => priority-bucket mode is off).
+  sched::BasicPriorityBuckets<FIXED_THREAD_SPACE> pending_buckets;  ///< Pending threads, by priority level.
+  sched::BasicPriorityBuckets<FIXED_THREAD_SPACE> active_buckets;   ///< Active threads, by priority level.
+  /// Per-thread-id scratch space used by ActivatePendingThreads to mark which pending threads to
+  /// activate (and which active thread, if any, each will replace). Entries are NO_ACTIVATION
+  /// outside of ActivatePendingThreads.
+  id_list_t activation_markers;
+  static constexpr size_t NO_ACTIVATION = std::numeric_limits<size_t>::max();
+  static constexpr size_t ACTIVATE_NO_REPLACE = NO_ACTIVATION - 1;
+  /// Debug builds only: which tracking structure (unused, pending, active, parked) each thread id
+  /// is in, so thread management asserts are O(1).
+  sched::ThreadMembership<FIXED_THREAD_SPACE> thread_membership;
+  /// Scratch buffer for module matches (see FindBestModuleMatch and SpawnThreads); reused so that
+  /// tag-based spawns do not allocate (if DERIVED_T provides FindModuleMatch(tag, n, matches)).
+  emp::vector<module_id_t> module_matches;
+
+  // Parallel execution mode (opt-in; see SetParallelExecution).
+  std::shared_ptr<sched::WorkerPool> worker_pool;  ///< Worker threads (null => serial execution).
+  bool in_parallel_phase=false;       ///< Are threads executing ahead, in parallel, right now?
+  emp::vector<size_t> parallel_batch; ///< Ids of threads executing ahead (in execution order).
+  emp::vector<size_t> ahead_quanta;   ///< Quantum of each thread executing ahead (NOT_AHEAD if none).
+  emp::vector<size_t> ahead_steps;    ///< Steps each thread took ahead (in the parallel phase).
+  static constexpr size_t NOT_AHEAD = std::numeric_limits<size_t>::max();
+  /// Thread that this OS thread is executing during a parallel phase.
+  static inline thread_local size_t parallel_cur_thread = std::numeric_limits<size_t>::max();
+
+  // State cycle detection (opt-in; see SetCycleDetection).
+  bool use_cycle_detection=false;     ///< Check for recurring states after each step?
+  bool halt_on_cycle=false;           ///< Halt the hardware when a state cycle is detected?
+  size_t cycle_check_interval=1;      ///< Number of steps between state checks.
+  sched::CycleDetector cycle_detector; ///< Watches the hashes of checked states for recurrences.
 
   // -- Custom component --
   custom_comp_t custom_component;  /**< Custom hardware component. This is convenient for problem-,
@@ -216,27 +308,45 @@ protected:
   /// - (3) mark thread as RUNNING.
   void ActivateThread(size_t thread_id) {
     emp_assert(thread_id < threads.size(), "Cannot activate invalid thread_id", thread_id);
-    emp_assert(!emp::Has(thread_exec_order, thread_id), "Duplicate thread ids in thread_exec_order", thread_id);
-    active_threads.emplace(thread_id);
-    thread_exec_order.emplace_back(thread_id);
-    threads[thread_id].SetRunning();
+    emp_assert(!thread_exec_order.Has(thread_id), "Duplicate thread ids in thread_exec_order", thread_id);
+    emp_assert(thread_membership.Check(thread_id, membership_t::PENDING), "Activating non-pending thread", thread_id);
+    InitDeferredThread(thread_id);
+    thread_membership.Set(thread_id, membership_t::ACTIVE);
+    active_threads.Insert(thread_id);
+    IndexActivePriority(thread_id);
+    thread_exec_order.PushBack(thread_id);
+    threads.SetRunState(thread_id, thread_state_t::RUNNING);
+  }
+
+  /// Initialize a spawned thread (via DERIVED_T::InitThread) if its initialization was deferred.
+  /// Spawned threads are initialized lazily, when activated (or accessed via GetThread), so that
+  /// pending threads that never run never pay for initialization.
+  void InitDeferredThread(size_t thread_id) {
+    if (!threads.IsInitDeferred(thread_id)) return;
+    const module_id_t module_id = threads.GetInitModule(thread_id);
+    threads.ClearInitDeferred(thread_id);
+    thread_t thread(threads[thread_id]);
+    GetHardware().InitThread(thread, module_id);
   }
 
   // TODO - Make a few public methods for killing threads by id
   /// Kill active thread:
-  /// - (1) Remove thread id from active_threads
+  /// - (1) Remove thread id from active_threads (and the execution order)
   /// - (2) mark thread as DEAD
   /// - (3) Reclaim thread id (put into unused_threads)
-  /// NOTE that this function does not remove this thread ID from the execution order. Calling KillActiveThread
-  /// on an active thread, then calling ActivateThread on the same id will result in an error.
   void KillActiveThread_impl(size_t thread_id) {
     emp_assert(thread_id < threads.size());
-    emp_assert(emp::Has(active_threads, thread_id), "Thread ID not in active_threads", thread_id);
-    emp_assert(!emp::Has(unused_threads, thread_id), "Thread ID already in unused_threads", thread_id);
-    active_threads.erase(thread_id);
+    emp_assert(active_threads.Has(thread_id), "Thread ID not in active_threads", thread_id);
+    emp_assert(thread_membership.Check(thread_id, membership_t::ACTIVE), "Thread ID not tracked as active", thread_id);
+    active_threads.Erase(thread_id);
+    UnindexActivePriority(thread_id);
+    if (thread_id == resume_thread_id) resume_thread_id = thread_exec_order.Next(thread_id);
+    thread_exec_order.Remove(thread_id);
+    blocked_threads.Remove(thread_id); // In case thread was blocked, but not yet parked.
     // NOTE: Don't want to reset thread here because this function could be called during this thread's execution.
-    threads[thread_id].SetDead();
+    threads.SetRunState(thread_id, thread_state_t::DEAD);
     unused_threads.emplace_back(thread_id);
+    thread_membership.Set(thread_id, membership_t::UNUSED);
   }
 
   /// Kill the next pending thread:
@@ -245,20 +355,319 @@ protected:
   /// - (3) Reclaim thread id (add to unused threads)
   void KillNextPendingThread() {
     emp_assert(pending_threads.size(), "Pending threads queue is empty.");
-    const size_t pending_id = pending_threads.front();
+    const size_t pending_id = pending_threads.Front();
     emp_assert(pending_id < threads.size());
-    emp_assert(!emp::Has(unused_threads, pending_id), "Thread ID already in unused_threads", pending_id);
-    pending_threads.pop_front();
-    threads[pending_id].SetDead();           // mark dead
+    emp_assert(thread_membership.Check(pending_id, membership_t::PENDING), "Thread ID not tracked as pending", pending_id);
+    pending_threads.PopFront();
+    UnindexPendingPriority(pending_id);
+    threads.SetRunState(pending_id, thread_state_t::DEAD); // mark dead
     unused_threads.emplace_back(pending_id); // reclaim pending_id for future use
+    thread_membership.Set(pending_id, membership_t::UNUSED);
+  }
+
+  /// Park a blocked active thread: remove it from active threads and the execution order (its
+  /// slot is freed for other threads). The thread remains BLOCKED in its wait list until woken.
+  void ParkBlockedThread(size_t thread_id) {
+    emp_assert(threads.GetRunState(thread_id) == thread_state_t::BLOCKED);
+    emp_assert(active_threads.Has(thread_id), "Thread ID not in active_threads", thread_id);
+    emp_assert(blocked_threads.Has(thread_id), "Blocked thread has no wait key", thread_id);
+    emp_assert(thread_membership.Check(thread_id, membership_t::ACTIVE), "Thread ID not tracked as active", thread_id);
+    active_threads.Erase(thread_id);
+    UnindexActivePriority(thread_id);
+    thread_exec_order.Remove(thread_id);
+    thread_membership.Set(thread_id, membership_t::PARKED);
+  }
+
+  /// Wake a blocked thread: remove it from its wait list and either resume it (if it has not
+  /// been parked yet) or queue it to be resumed (see ResumeWokenThreads).
+  void WakeThread_impl(size_t thread_id) {
+    emp_assert(blocked_threads.Has(thread_id));
+    blocked_threads.Remove(thread_id);
+    if (active_threads.Has(thread_id)) {
+      threads.SetRunState(thread_id, thread_state_t::RUNNING);
+    } else {
+      emp_assert(thread_membership.Check(thread_id, membership_t::PARKED), "Thread ID not tracked as parked", thread_id);
+      threads.SetRunState(thread_id, thread_state_t::PENDING);
+      woken_threads.PushBack(thread_id);
+      thread_membership.Set(thread_id, membership_t::WOKEN);
+    }
+    if (is_executing) ++thread_change_cnt;
+  }
+
+  /// Resume woken threads (in the order they were woken) while there are free active slots.
+  /// Woken threads never displace active threads; any that do not fit stay parked.
+  void ResumeWokenThreads() {
+    while (woken_threads.size() && (active_threads.size() < max_active_threads)) {
+      const size_t thread_id = woken_threads.Front();
+      emp_assert(thread_membership.Check(thread_id, membership_t::WOKEN), "Thread ID not tracked as woken", thread_id);
+      woken_threads.PopFront();
+      thread_membership.Set(thread_id, membership_t::ACTIVE);
+      active_threads.Insert(thread_id);
+      IndexActivePriority(thread_id);
+      thread_exec_order.PushBack(thread_id);
+      threads.SetRunState(thread_id, thread_state_t::RUNNING);
+    }
+  }
+
+  /// Resize thread storage, keeping id-indexed thread management structures in sync.
+  void ResizeThreadStorage(size_t n) {
+    threads.Resize(n);
+    thread_membership.Resize(n);
+    active_threads.Resize(n);
+    thread_exec_order.Resize(n);
+    blocked_threads.Resize(n);
+    if constexpr (SCHED_INDEXES_PRIORITY) {
+      pending_priorities_MAX.Resize(n);
+      pending_priorities_MIN.Resize(n);
+      active_priorities_MIN.Resize(n);
+      pending_buckets.Resize(n);
+      active_buckets.Resize(n);
+      activation_markers.resize(n, NO_ACTIVATION);
+    }
+    pending_threads.Reserve(n);
+    woken_threads.Reserve(n);
+  }
+
+  /// Get the character used to represent a thread state in PrintThreadUsage.
+  static char GetThreadStateChar(thread_state_t state) {
+    switch (state) {
+      case thread_state_t::DEAD: return 'D';
+      case thread_state_t::RUNNING: return 'A';
+      case thread_state_t::PENDING: return 'P';
+      case thread_state_t::BLOCKED: return 'B';
+    }
+    return '?';
+  }
+
+  /// Minimum fair-share weight (threads with lower priorities are treated as having this weight).
+  static constexpr double FAIR_SHARE_MIN_WEIGHT = 1.0 / 64.0;
+
+  /// Get the weight of the given thread in fair-share mode.
+  double GetFairShareWeight(size_t thread_id) const {
+    return std::max(threads.GetPriority(thread_id), FAIR_SHARE_MIN_WEIGHT);
+  }
+
+  /// Credit the given thread with its fair share of execution steps for this SingleProcess, and
+  /// return the number of execution steps it should take now. A thread that has never executed
+  /// always gets at least one execution step (its credit may go negative).
+  size_t GetFairShareQuantum(size_t thread_id) {
+    const double credit = std::min(
+      threads.GetCredit(thread_id) + GetFairShareWeight(thread_id) * (double)thread_quantum,
+      (double)fair_share_max_quantum
+    );
+    threads.SetCredit(thread_id, credit);
+    if (credit >= 1.0) return (size_t)credit;
+    return threads.GetNumExecSteps(thread_id) ? 0 : 1;
+  }
+
+  /// Charge the given thread for the execution steps it took (in fair-share mode).
+  void ChargeFairShare(size_t thread_id, size_t num_steps) {
+    threads.SetCredit(thread_id, threads.GetCredit(thread_id) - (double)num_steps);
+    threads.AddVirtualRuntime(thread_id, (double)num_steps / GetFairShareWeight(thread_id));
+  }
+
+  /// Record that the given thread is taking its first execution step now.
+  void RecordFirstExecStep(size_t thread_id) {
+    const size_t step = GetNumSteps();
+    threads.SetFirstExecStep(thread_id, step);
+    max_spawn_latency = std::max(max_spawn_latency, step - threads.GetSpawnStep(thread_id));
+  }
+
+  /// Get the heap key used to order the given thread by priority.
+  priority_key_t GetPriorityKey(size_t thread_id) const {
+    return std::make_tuple(threads.GetPriority(thread_id), thread_id);
+  }
+
+  // -- Thread priority index --
+  // Pending and active threads are indexed by priority, either in heaps (default) or, in
+  // priority-bucket mode, in per-level queues. Scheduling decisions go through these functions.
+  // Scheduler policies that do not use priority (see SCHED_INDEXES_PRIORITY) skip indexing.
+  bool IsPriorityBucketMode() const {
+    if constexpr (SCHED_CONFIGURABLE) return num_priority_levels > 0;
+    else return scheduler_t::NUM_PRIORITY_LEVELS > 0;
+  }
+
+  /// Get the priority used to make scheduling decisions for the given (raw) priority: in
+  /// priority-bucket mode, this is the priority's level; otherwise, the priority itself.
+  double GetSchedPriority(double priority) const {
+    return IsPriorityBucketMode() ? (double)GetPriorityLevel(priority) : priority;
+  }
+
+  /// Get the priority used to make scheduling decisions for the given thread.
+  double GetThreadSchedPriority(size_t thread_id) const {
+    return GetSchedPriority(threads.GetPriority(thread_id));
+  }
+
+  void IndexPendingPriority(size_t thread_id) {
+    if constexpr (!SCHED_INDEXES_PRIORITY) return;
+    if (IsPriorityBucketMode()) {
+      pending_buckets.Push(thread_id, GetPriorityLevel(threads.GetPriority(thread_id)));
+    } else {
+      pending_priorities_MAX.Push(thread_id, GetPriorityKey(thread_id));
+      pending_priorities_MIN.Push(thread_id, GetPriorityKey(thread_id));
+    }
+  }
+
+  /// Remove thread from the pending priority index (if it is there).
+  void UnindexPendingPriority(size_t thread_id) {
+    if constexpr (!SCHED_INDEXES_PRIORITY) return;
+    if (IsPriorityBucketMode()) {
+      pending_buckets.Remove(thread_id);
+    } else {
+      pending_priorities_MAX.Remove(thread_id);
+      pending_priorities_MIN.Remove(thread_id);
+    }
+  }
+
+  void IndexActivePriority(size_t thread_id) {
+    if constexpr (!SCHED_INDEXES_PRIORITY) return;
+    if (IsPriorityBucketMode()) {
+      active_buckets.Push(thread_id, GetPriorityLevel(threads.GetPriority(thread_id)));
+    } else {
+      active_priorities_MIN.Push(thread_id, GetPriorityKey(thread_id));
+    }
+  }
+
+  /// Remove thread from the active priority index (if it is there).
+  void UnindexActivePriority(size_t thread_id) {
+    if constexpr (!SCHED_INDEXES_PRIORITY) return;
+    if (IsPriorityBucketMode()) active_buckets.Remove(thread_id);
+    else active_priorities_MIN.Remove(thread_id);
+  }
+
+  /// Update the priority index after the given thread's priority changed.
+  void ReindexPriority(size_t thread_id) {
+    if constexpr (!SCHED_INDEXES_PRIORITY) return;
+    if (IsPriorityBucketMode()) {
+      const size_t level = GetPriorityLevel(threads.GetPriority(thread_id));
+      if (active_buckets.Has(thread_id)) active_buckets.Update(thread_id, level);
+      if (pending_buckets.Has(thread_id)) pending_buckets.Update(thread_id, level);
+    } else {
+      const priority_key_t key(GetPriorityKey(thread_id));
+      if (active_priorities_MIN.Has(thread_id)) active_priorities_MIN.Update(thread_id, key);
+      if (pending_priorities_MAX.Has(thread_id)) pending_priorities_MAX.Update(thread_id, key);
+      if (pending_priorities_MIN.Has(thread_id)) pending_priorities_MIN.Update(thread_id, key);
+    }
+  }
+
+  /// Number of pending threads in the priority index that have not been popped (see PopMaxPending).
+  size_t GetNumIndexedPending() const {
+    return IsPriorityBucketMode() ? pending_buckets.size() : pending_priorities_MAX.size();
+  }
+
+  size_t GetNumIndexedActive() const {
+    return IsPriorityBucketMode() ? active_buckets.size() : active_priorities_MIN.size();
+  }
+
+  /// Get the highest-priority pending thread.
+  size_t PeekMaxPending() const {
+    return IsPriorityBucketMode() ? pending_buckets.GetMaxID() : pending_priorities_MAX.Top();
+  }
+
+  /// Get the lowest-priority pending thread.
+  size_t PeekMinPending() const {
+    return IsPriorityBucketMode() ? pending_buckets.GetMinID() : pending_priorities_MIN.Top();
+  }
+
+  /// Get the lowest-priority active thread.
+  size_t PeekMinActive() const {
+    return IsPriorityBucketMode() ? active_buckets.GetMinID() : active_priorities_MIN.Top();
+  }
+
+  /// Remove the highest-priority pending thread from consideration by PeekMaxPending, and return it.
+  /// NOTE: the thread may still be found by PeekMinPending until UnindexPendingPriority is called.
+  size_t PopMaxPending() {
+    return IsPriorityBucketMode() ? pending_buckets.PopMax() : pending_priorities_MAX.Pop();
+  }
+
+  /// Remove the lowest-priority active thread from the priority index, and return it.
+  size_t PopMinActive() {
+    return IsPriorityBucketMode() ? active_buckets.PopMin() : active_priorities_MIN.Pop();
   }
 
   /// Attempt to activate all pending threads.
   void ActivatePendingThreads();
 
+  /// Internal implementation of ActivatePendingThreads that uses priority to decide which pending
+  /// threads to activate (and which active threads they replace).
+  void ActivatePendingThreads_UsePriority_impl();
+
+  /// Internal implementation of ActivatePendingThreads that activates pending threads in order of
+  /// arrival while there is room.
+  void ActivatePendingThreads_NoPriority_impl();
+
   /// Internal implementation of SetActiveThreadLimit
   void SetActiveThreadLimit_impl(size_t n);
 
+  /// Take a step (or resume a paused step; see ProcessFor). Between two threads' turns (in serial
+  /// execution), the step pauses if should_pause() returns true.
+  /// @return true if the step finished.
+  template<typename PAUSE_FUN_T>
+  bool SingleProcess_impl(PAUSE_FUN_T& should_pause);
+
+  /// Execute active threads (SingleProcess) in parallel execution mode (see SetParallelExecution).
+  void ExecuteThreads_Parallel_impl();
+
+  /// After a step: check whether the hardware's state has recurred (see SetCycleDetection).
+  void CheckForCycle() {
+    if constexpr (decltype(DetectHashState<DERIVED_T>(0))::value) {
+      if (cycle_detector.IsCycleDetected()) return;
+      // With events queued or scheduled, execution depends on more than the hardware's state.
+      if (!event_queue.empty() || !event_wheel.empty()) {
+        cycle_detector.Reset();
+        return;
+      }
+      // Likewise, a hardware with nothing to run (idle, or every thread blocked) is waiting for
+      // outside input, not livelocked.
+      if (IsWaiting()) {
+        cycle_detector.Reset();
+        return;
+      }
+      if (GetNumSteps() % cycle_check_interval) return;
+      if (cycle_detector.Observe(GetStateHash()) && halt_on_cycle) is_halted = true;
+    }
+  }
+
+  /// Is there nothing for the hardware to run (no pending threads, and every active thread, if any,
+  /// is blocked)?
+  bool IsWaiting() const {
+    if (!pending_threads.empty() || !woken_threads.empty()) return false;
+    for (size_t id : thread_exec_order) {
+      if (threads.GetRunState(id) != thread_state_t::BLOCKED) return false;
+    }
+    return true;
+  }
+
+  /// Note a change made to the hardware from outside of execution (e.g., a spawn or a queued
+  /// event): previously checked states no longer predict execution (see ResetCycleDetection).
+  void OnExternalChange() {
+    if (use_cycle_detection && !is_executing) ResetCycleDetection();
+  }
+
+  /// Combine the given thread's state into a running state hash (see GetStateHash).
+  size_t HashThread(size_t hash, size_t thread_id) const {
+    hash = utils::HashCombine(hash, thread_id);
+    hash = utils::HashCombine(hash, threads.GetRunState(thread_id));
+    hash = utils::HashCombine(hash, threads.GetPriority(thread_id));
+    hash = utils::HashCombine(hash, threads.GetNumExecSteps(thread_id) > 0);
+    if (IsFairShareSchedulingUsed()) hash = utils::HashCombine(hash, threads.GetCredit(thread_id));
+    if (threads.IsInitDeferred(thread_id)) {
+      return utils::HashCombine(hash, threads.GetInitModule(thread_id));
+    }
+    return utils::HashCombine(hash, GetHardware().HashExecState(threads.GetExecState(thread_id)));
+  }
+
+  /// ID of the thread currently executing on this OS thread (during execution).
+  size_t GetCurThreadID_impl() const {
+    return in_parallel_phase ? parallel_cur_thread : cur_thread.id;
+  }
+
+  /// Did the given thread execute ahead, in parallel, during the current SingleProcess (and is it
+  /// still waiting for the rest of its turn)?
+  bool IsThreadAhead(size_t thread_id) const {
+    return thread_id < ahead_quanta.size() && ahead_quanta[thread_id] != NOT_AHEAD;
+  }
+
   // todo - test!
   /// Internal implementation of SetActiveThreadLimit that uses priority to decide which threads
   /// to kill if necessary.
@@ -268,17 +677,207 @@ protected:
   /// kill if necessary.
   void SetActiveThreadLimit_NoPriority_impl(size_t n);
 
-  /// REQUIRED - Must be implemented by DERIVED_T
-  /// ResetImpl should fully reset any hardware state information tracked by DERIVED_T.
-  /// ResetImpl is called by THIS_T::Reset before doing a ResetBaseHardwareState.
-  virtual void ResetImpl() = 0;
+  // -- Detection of DERIVED_T's required interface (see REQUIREMENTS) --
+  // NOTE: these are members so that access is checked from BaseCPU (which DERIVED_T may befriend).
+  template<typename HW_T>
+  static auto DetectResetImpl(int) -> decltype(std::declval<HW_T&>().ResetImpl(), std::true_type());
+  template<typename HW_T>
+  static std::false_type DetectResetImpl(...);
+
+  template<typename HW_T>
+  static auto DetectSingleExecutionStep(int) -> decltype(
+    std::declval<HW_T&>().SingleExecutionStep(std::declval<HW_T&>(), std::declval<thread_t&>()),
+    std::true_type()
+  );
+  template<typename HW_T>
+  static std::false_type DetectSingleExecutionStep(...);
+
+  template<typename HW_T>
+  static auto DetectFindModuleMatch(int) -> std::is_convertible<
+    decltype(std::declval<HW_T&>().FindModuleMatch(std::declval<const tag_t&>(), size_t())),
+    emp::vector<module_id_t>
+  >;
+  template<typename HW_T>
+  static std::false_type DetectFindModuleMatch(...);
+
+  template<typename EVENT_T>
+  static auto DetectEventTag(int) -> std::is_convertible<
+    decltype(std::declval<const EVENT_T&>().GetTag()),
+    const tag_t&
+  >;
+  template<typename EVENT_T>
+  static std::false_type DetectEventTag(...);
+
+  template<typename HW_T>
+  static auto DetectFindModuleMatchInto(int) -> decltype(
+    std::declval<HW_T&>().FindModuleMatch(
+      std::declval<const tag_t&>(),
+      size_t(),
+      std::declval<emp::vector<module_id_t>&>()
+    ),
+    std::true_type()
+  );
+  template<typename HW_T>
+  static std::false_type DetectFindModuleMatchInto(...);
+
+  template<typename HW_T>
+  static auto DetectInitThread(int) -> decltype(
+    std::declval<HW_T&>().InitThread(std::declval<thread_t&>(), module_id_t()),
+    std::true_type()
+  );
+  template<typename HW_T>
+  static std::false_type DetectInitThread(...);
+
+  template<typename HW_T>
+  static auto DetectIsThreadLocalStep(int) -> std::is_convertible<
+    decltype(std::declval<HW_T&>().IsThreadLocalStep(std::declval<thread_t&>())),
+    bool
+  >;
+  template<typename HW_T>
+  static std::false_type DetectIsThreadLocalStep(...);
+
+  template<typename HW_T, typename SNAPSHOT_T>
+  static auto DetectSaveState(int) -> decltype(
+    std::declval<const HW_T&>().SaveState(std::declval<SNAPSHOT_T&>()),
+    std::true_type()
+  );
+  template<typename HW_T, typename SNAPSHOT_T>
+  static std::false_type DetectSaveState(...);
+
+  template<typename HW_T, typename SNAPSHOT_T>
+  static auto DetectRestoreState(int) -> decltype(
+    std::declval<HW_T&>().RestoreState(std::declval<const SNAPSHOT_T&>()),
+    std::true_type()
+  );
+  template<typename HW_T, typename SNAPSHOT_T>
+  static std::false_type DetectRestoreState(...);
+
+  template<typename HW_T>
+  static auto DetectHashState(int) -> decltype(
+    std::declval<const HW_T&>().HashState(),
+    std::declval<const HW_T&>().HashExecState(std::declval<const typename HW_T::exec_state_t&>()),
+    std::true_type()
+  );
+  template<typename HW_T>
+  static std::false_type DetectHashState(...);
+
+  /// Snapshot type of the given hardware type (HW_T::snapshot_t, or BaseState if not defined).
+  template<typename HW_T, typename=void>
+  struct SnapshotType { using type = BaseState; };
+  template<typename HW_T>
+  struct SnapshotType<HW_T, std::void_t<typename HW_T::snapshot_t>> { using type = typename HW_T::snapshot_t; };
+
+  /// Copy BaseCPU's snapshot state (see BaseState) from one object to another: from hardware to a
+  /// snapshot, or from a snapshot to hardware. Copy assignment reuses the destination's storage.
+  template<typename FROM_T, typename TO_T>
+  static void CopyBaseState(const FROM_T& from, TO_T& to) {
+    to.event_queue = from.event_queue;
+    to.event_wheel = from.event_wheel;
+    to.max_active_threads = from.max_active_threads;
+    to.max_thread_space = from.max_thread_space;
+    to.use_thread_priority = from.use_thread_priority;
+    to.use_spawn_admission_control = from.use_spawn_admission_control;
+    to.thread_quantum = from.thread_quantum;
+    to.yield_on_thread_change = from.yield_on_thread_change;
+    to.use_fair_share = from.use_fair_share;
+    to.fair_share_max_quantum = from.fair_share_max_quantum;
+    to.max_spawn_latency = from.max_spawn_latency;
+    to.num_instructions = from.num_instructions;
+    to.step_in_progress = from.step_in_progress;
+    to.resume_thread_id = from.resume_thread_id;
+    to.is_halted = from.is_halted;
+    to.cycle_detector = from.cycle_detector;
+    to.threads = from.threads;
+    to.thread_exec_order = from.thread_exec_order;
+    to.active_threads = from.active_threads;
+    to.unused_threads = from.unused_threads;
+    to.pending_threads = from.pending_threads;
+    to.blocked_threads = from.blocked_threads;
+    to.woken_threads = from.woken_threads;
+    to.pending_priorities_MAX = from.pending_priorities_MAX;
+    to.pending_priorities_MIN = from.pending_priorities_MIN;
+    to.active_priorities_MIN = from.active_priorities_MIN;
+    to.num_priority_levels = from.num_priority_levels;
+    to.pending_buckets = from.pending_buckets;
+    to.active_buckets = from.active_buckets;
+    to.activation_markers = from.activation_markers;
+    to.thread_membership = from.thread_membership;
+    to.custom_component = from.custom_component;
+  }
+
+  /// Destructor (BaseCPU is not meant to be used polymorphically).
+  ~BaseCPU() = default;
 
 public:
+  /// BaseCPU's part of a hardware snapshot (see Snapshot): threads (including their execution
+  /// states), scheduler settings and bookkeeping, queued and scheduled events (shared with the
+  /// hardware; events are immutable), and the custom component.
+  struct BaseState {
+    sched::RingBuffer<std::shared_ptr<event_t>> event_queue;
+    sched::TimingWheel<std::shared_ptr<event_t>> event_wheel;
+    size_t max_active_threads=0;
+    size_t max_thread_space=0;
+    bool use_thread_priority=false;
+    bool use_spawn_admission_control=false;
+    size_t thread_quantum=0;
+    bool yield_on_thread_change=false;
+    bool use_fair_share=false;
+    size_t fair_share_max_quantum=0;
+    size_t max_spawn_latency=0;
+    size_t num_instructions=0;
+    bool step_in_progress=false;
+    size_t resume_thread_id=sched::RunList::npos;
+    bool is_halted=false;
+    sched::CycleDetector cycle_detector;
+    thread_table_t threads;
+    run_list_t thread_exec_order;
+    active_set_t active_threads;
+    id_list_t unused_threads;
+    pending_queue_t pending_threads;
+    wait_lists_t blocked_threads;
+    pending_queue_t woken_threads;
+    sched::IndexedHeap<priority_key_t, std::less<priority_key_t>, FIXED_THREAD_SPACE> pending_priorities_MAX;
+    sched::IndexedHeap<priority_key_t, std::greater<priority_key_t>, FIXED_THREAD_SPACE> pending_priorities_MIN;
+    sched::IndexedHeap<priority_key_t, std::greater<priority_key_t>, FIXED_THREAD_SPACE> active_priorities_MIN;
+    size_t num_priority_levels=0;
+    sched::BasicPriorityBuckets<FIXED_THREAD_SPACE> pending_buckets;
+    sched::BasicPriorityBuckets<FIXED_THREAD_SPACE> active_buckets;
+    id_list_t activation_markers;
+    sched::ThreadMembership<FIXED_THREAD_SPACE> thread_membership;
+    custom_comp_t custom_component;
+  };
+
   BaseCPU(event_lib_t& elib)
     : event_lib(elib),
-      threads(std::min(2*max_active_threads, max_thread_space)),
-      unused_threads(threads.size())
+      threads(FIXED_CAPACITY ? FIXED_THREAD_SPACE : std::min(2*max_active_threads, max_thread_space)),
+      thread_exec_order(threads.size()),
+      active_threads(threads.size()),
+      unused_threads(threads.size()),
+      blocked_threads(threads.size()),
+      pending_priorities_MAX(SCHED_INDEXES_PRIORITY ? threads.size() : 0),
+      pending_priorities_MIN(SCHED_INDEXES_PRIORITY ? threads.size() : 0),
+      active_priorities_MIN(SCHED_INDEXES_PRIORITY ? threads.size() : 0),
+      pending_buckets(
+        SCHED_INDEXES_PRIORITY ? threads.size() : 0,
+        scheduler_t::NUM_PRIORITY_LEVELS ? scheduler_t::NUM_PRIORITY_LEVELS : sched::PriorityBuckets::MAX_LEVELS
+      ),
+      active_buckets(
+        SCHED_INDEXES_PRIORITY ? threads.size() : 0,
+        scheduler_t::NUM_PRIORITY_LEVELS ? scheduler_t::NUM_PRIORITY_LEVELS : sched::PriorityBuckets::MAX_LEVELS
+      ),
+      activation_markers(SCHED_INDEXES_PRIORITY ? threads.size() : 0, NO_ACTIVATION),
+      thread_membership(threads.size(), sched::Membership::UNUSED)
   {
+    static_assert(decltype(DetectResetImpl<DERIVED_T>(0))::value,
+      "DERIVED_T must implement void ResetImpl().");
+    static_assert(decltype(DetectSingleExecutionStep<DERIVED_T>(0))::value,
+      "DERIVED_T must implement void SingleExecutionStep(DERIVED_T&, thread_t&).");
+    static_assert(decltype(DetectFindModuleMatch<DERIVED_T>(0))::value,
+      "DERIVED_T must implement emp::vector<module_id_t> FindModuleMatch(const tag_t&, size_t).");
+    static_assert(decltype(DetectInitThread<DERIVED_T>(0))::value,
+      "DERIVED_T must implement void InitThread(thread_t&, module_id_t).");
+    pending_threads.Reserve(threads.size());
+    woken_threads.Reserve(threads.size());
     // Set all threads to unused.
     for (size_t i = 0; i < unused_threads.size(); ++i) {
       unused_threads[i] = (unused_threads.size() - 1) - i;
@@ -291,25 +890,6 @@ public:
   /// Copy constructor.
   BaseCPU(const BaseCPU& in) = default;
 
-  /// Destructor.
-  virtual ~BaseCPU() {};
-
-  /// REQUIRED - Must be implemented by DERIVED_T
-  /// This function should advance the given thread by a single step on the given DERIVED_T implementation
-  /// of SignalGP.
-  virtual void SingleExecutionStep(DERIVED_T &, thread_t &) = 0;
-
-  /// REQUIRED - Must be implemented by DERIVED_T
-  /// Given a TAG_T (tag) and a maximum number of modules to search for (n), return a vector of valid
-  /// module matches (valid as specified by DERIVED_T).
-  /// It is valid for the return value to have a size from [0:n].
-  virtual emp::vector<module_id_t> FindModuleMatch(const tag_t &, size_t) = 0;
-
-  /// REQUIRED - Must be implemented by DERIVED_T
-  /// This function should take a thread_t & thread and size_t module_id as input and initialize
-  /// the given thread using the specified module_id.
-  virtual void InitThread(thread_t &, module_id_t) = 0;
-
   /// Reset the base hardware state:
   /// - Clear event queue.
   /// - Reset all threads, move all to unused; clear pending.
@@ -319,28 +899,42 @@ public:
   /// Cannot call while hardware is executing.
   void ResetThreads() {
     emp_assert(!is_executing, "Cannot reset hardware while executing.");
-    for (auto & thread : threads) {
-      thread.Reset();
-    }
-    thread_exec_order.clear(); // No threads to execute.
-    active_threads.clear();    // No active threads.
-    pending_threads.clear();   // No pending threads.
+    threads.ResetAll();
+    thread_exec_order.Clear(); // No threads to execute.
+    active_threads.Clear();    // No active threads.
+    pending_threads.Clear();   // No pending threads.
+    blocked_threads.Clear();   // No blocked threads.
+    woken_threads.Clear();
+    pending_priorities_MAX.Clear();
+    pending_priorities_MIN.Clear();
+    active_priorities_MIN.Clear();
+    pending_buckets.Clear();
+    active_buckets.Clear();
     unused_threads.resize(threads.size());
     // Add all available threads to unused.
     for (size_t i = 0; i < unused_threads.size(); ++i) {
       unused_threads[i] = (unused_threads.size() - 1) - i;
     }
+    thread_membership.Reset(threads.size(), membership_t::UNUSED);
     cur_thread.Invalidate();
     cur_thread.id = max_thread_space;
+    step_in_progress = false;
+    resume_thread_id = sched::RunList::npos;
   }
 
-  /// Remove all events from event queue.
+  /// Remove all events from event queue (including events scheduled for future steps).
   /// Safe to do while executing.
-  void ClearEventQueue() { event_queue.clear(); }
+  void ClearEventQueue() {
+    while (!event_queue.empty()) {
+      event_queue.Front().reset();
+      event_queue.PopFront();
+    }
+    event_wheel.Clear();
+  }
 
   /// Full hardware reset.
   void Reset() {
-    ResetImpl();
+    GetHardware().ResetImpl();
     ResetBaseHardwareState();
   }
 
@@ -377,49 +971,104 @@ public:
   /// Get number of threads being considered for activation.
   size_t GetNumPendingThreads() const { return pending_threads.size(); }
 
+  /// Get number of blocked threads (waiting to be woken).
+  size_t GetNumBlockedThreads() const { return blocked_threads.size(); }
+
+  /// Get number of woken threads still parked, waiting for an active slot (see WakeThread).
+  size_t GetNumWokenThreads() const { return woken_threads.size(); }
+
   /// Get number of unused threads. May be larger than max number of active threads.
   size_t GetNumUnusedThreads() const { return unused_threads.size(); }
 
   /// Get the number of queue events.
   size_t GetNumQueuedEvents() const { return event_queue.size(); }
 
-  /// Get a reference to all threads (each thread may be RUNNING, PENDING, or DEAD).
+  /// Get the number of events scheduled for future steps (see QueueEventAt).
+  size_t GetNumScheduledEvents() const { return event_wheel.size(); }
+
+  /// Get the number of times SingleProcess has been called (since the last hardware reset).
+  /// A step paused by ProcessFor counts as soon as it starts.
+  size_t GetNumSteps() const { return event_wheel.GetTime(); }
+
+  /// Get the number of instructions (thread execution steps) executed since the last hardware reset.
+  size_t GetNumInstructions() const { return num_instructions; }
+
+  /// Was the current step paused partway through by ProcessFor? (If so, the next SingleProcess or
+  /// ProcessFor call finishes it.)
+  bool IsStepInProgress() const { return step_in_progress; }
+
+  /// Get a reference to all threads (each thread may be RUNNING, PENDING, BLOCKED, or DEAD).
   /// NOTE: use responsibly, there are no safety gloves here!
   /// It is safe to:
   /// - manipulate thread exec_state information
-  /// - manipulate thread priority
+  /// - manipulate thread priority (via SetThreadPriority)
   /// - mark a running thread as dead
   /// It is NOT safe to:
   /// - mark a pending thread as dead or running
   /// - mark a running thread as pending
   /// - mark a dead thread as running or pending
+  /// - mark any thread as blocked (use BlockThread) or mark a blocked thread as anything else
   /// TIP: you can use emp_assert(ValidateThreadState()) after doing whatever it is you want to do
   /// to assert that the thread management system is in a safe state.
-  emp::vector<thread_t>& GetThreads() { return threads; }
+  /// NOTE: initializes any pending threads whose initialization was deferred (use ViewThreads to
+  /// inspect thread metadata without doing so).
+  thread_table_t& GetThreads() {
+    for (size_t id : pending_threads) InitDeferredThread(id);
+    return threads;
+  }
+
+  /// Get a const reference to all threads without initializing deferred pending threads.
+  /// Run states, priorities, and storage size are always valid; a pending thread's execution state
+  /// may not be initialized yet (see IsInitDeferred).
+  const thread_table_t& ViewThreads() const { return threads; }
 
-  /// Get a reference to a particular thread.
-  thread_t& GetThread(size_t i) {
+  /// Get a handle to a particular thread.
+  /// If the thread is pending and its initialization was deferred, it is initialized now.
+  thread_t GetThread(size_t i) {
     emp_assert(i < threads.size());
+    InitDeferredThread(i);
     return threads[i];
   }
 
-  const thread_t& GetThread(size_t i) const {
+  /// Get a const handle to a particular thread.
+  /// NOTE: a pending thread's execution state may not be initialized yet (see IsInitDeferred).
+  const thread_t GetThread(size_t i) const {
     emp_assert(i < threads.size());
     return threads[i];
   }
 
-  /// Get const reference to vector of currently active threads active.
-  const std::unordered_set<size_t>& GetActiveThreadIDs() const { return active_threads; }
+  /// Get const reference to the set of currently active thread ids.
+  /// Iteration order is arbitrary; membership tests (Has) are O(1).
+  const active_set_t& GetActiveThreadIDs() const { return active_threads; }
 
   /// Get const reference to threads that are not currently active.
-  const emp::vector<size_t>& GetUnusedThreadIDs() const { return unused_threads; }
+  const id_list_t& GetUnusedThreadIDs() const { return unused_threads; }
+
+  /// Get const reference to the wait lists of blocked threads.
+  const wait_lists_t& GetBlockedThreadIDs() const { return blocked_threads; }
 
   /// Get const reference to thread ids of pending threads.
-  const std::deque<size_t>& GetPendingThreadIDs() const { return pending_threads; }
+  const pending_queue_t& GetPendingThreadIDs() const { return pending_threads; }
+
+  /// Get const reference to thread ids of woken threads waiting for an active slot (in the order
+  /// they were woken).
+  const pending_queue_t& GetWokenThreadIDs() const { return woken_threads; }
 
   /// Get const reference to thread execution order. Note, not all threads in exec
   /// order list guaranteed to be active.
-  const emp::vector<size_t>& GetThreadExecOrder() const { return thread_exec_order; }
+  /// NOTE: the returned vector is a snapshot of the execution order, rebuilt (O(n)) if the
+  ///       execution order has changed since the last call. Use GetThreadRunList to iterate over
+  ///       the execution order without copying.
+  const emp::vector<size_t>& GetThreadExecOrder() const {
+    if (thread_exec_order_cache_version != thread_exec_order.GetVersion()) {
+      thread_exec_order_cache.assign(thread_exec_order.begin(), thread_exec_order.end());
+      thread_exec_order_cache_version = thread_exec_order.GetVersion();
+    }
+    return thread_exec_order_cache;
+  }
+
+  /// Get const reference to the thread execution order (as a linked list of thread ids).
+  const run_list_t& GetThreadRunList() const { return thread_exec_order; }
 
   /// Get the ID of the currently executing thread.
   /// This function will only provide a valid thread WHILE the hardware is executing.
@@ -428,27 +1077,332 @@ public:
   size_t GetCurThreadID() {
     emp_assert(is_executing);
     emp_assert(cur_thread.IsValid(), "There is no currently executing thread.");
-    emp_assert(cur_thread.ID() < threads.size(), "Current thread ID is invalid.");
-    return cur_thread.ID();
+    emp_assert(GetCurThreadID_impl() < threads.size(), "Current thread ID is invalid.");
+    return GetCurThreadID_impl();
   }
 
-  /// Get the currently executing thread.
+  /// Get (a handle to) the currently executing thread.
   /// This function will only provide a valid thread WHILE the hardware is executing.
-  thread_t & GetCurThread() {
+  thread_t GetCurThread() {
     emp_assert(is_executing, "Hardware is not executing! No current thread.");
     emp_assert(cur_thread.IsValid(), "There is no currently executing thread.");
-    emp_assert(cur_thread.ID() < threads.size(), "Current thread ID is invalid.");
-    return threads[cur_thread.ID()];
+    emp_assert(GetCurThreadID_impl() < threads.size(), "Current thread ID is invalid.");
+    return threads[GetCurThreadID_impl()];
   }
 
   /// Are we inside of a 'SingleProcess'. Note, for traditional GP versions of SignalGP, GP instructions
   /// are processed while the hardware is executing.
   bool IsExecuting() const { return is_executing; }
 
-  bool IsThreadPriorityUsed() const { return use_thread_priority; }
+  bool IsThreadPriorityUsed() const {
+    if constexpr (SCHED_CONFIGURABLE) return use_thread_priority;
+    else return scheduler_t::USE_PRIORITY;
+  }
 
   /// Should this hardware use thread priority?
-  void SetThreadPriorityUse(bool use_priority=true) { use_thread_priority = use_priority; }
+  /// NOTE: fixed by non-configurable scheduler policies (see SCHEDULER_T).
+  void SetThreadPriorityUse(bool use_priority=true) {
+    emp_assert(SCHED_CONFIGURABLE || use_priority == scheduler_t::USE_PRIORITY,
+      "Thread priority use is fixed by the scheduler policy.");
+    if constexpr (SCHED_CONFIGURABLE) use_thread_priority = use_priority;
+  }
+
+  /// Get the maximum number of execution steps each thread gets per SingleProcess.
+  size_t GetThreadQuantum() const {
+    if constexpr (SCHED_CONFIGURABLE) return thread_quantum;
+    else return scheduler_t::QUANTUM;
+  }
+
+  /// Set the maximum number of execution steps each thread gets per SingleProcess (default: 1).
+  /// A larger quantum amortizes per-SingleProcess scheduling overhead (event handling, thread
+  /// activation) over more instructions. A thread's quantum ends early if the thread dies.
+  /// NOTE: fixed by non-configurable scheduler policies (see SCHEDULER_T).
+  void SetThreadQuantum(size_t quantum) {
+    emp_assert(quantum > 0, "Thread quantum must be > 0.");
+    emp_assert(SCHED_CONFIGURABLE || quantum == scheduler_t::QUANTUM,
+      "Thread quantum is fixed by the scheduler policy.");
+    if constexpr (SCHED_CONFIGURABLE) thread_quantum = quantum;
+  }
+
+  bool IsYieldOnThreadChange() const { return yield_on_thread_change; }
+
+  /// Should a thread yield the remainder of its quantum when it spawns or kills a thread?
+  /// (Only matters when the thread quantum > 1.)
+  void SetYieldOnThreadChange(bool yield=true) { yield_on_thread_change = yield; }
+
+  bool IsFairShareSchedulingUsed() const {
+    if constexpr (SCHED_CONFIGURABLE) return use_fair_share;
+    else return false;
+  }
+
+  /// Opt in to (or out of) weighted fair-share scheduling. In fair-share mode, instead of a fixed
+  /// quantum, each active thread earns max(priority, 1/64) * thread quantum execution steps of
+  /// credit per SingleProcess (so, e.g., a priority-4 thread executes four times as many steps as a
+  /// priority-1 thread), and a thread's virtual runtime (execution steps / weight) is tracked.
+  /// - Credit is capped at the fair-share max quantum (see SetFairShareMaxQuantum), which bounds
+  ///   the cost of a SingleProcess at max active threads * max quantum execution steps.
+  /// - Latency guarantee: a newly activated thread always executes at least one step in the
+  ///   SingleProcess that activates it. So, a thread spawned while handling an event executes its
+  ///   first step in the same SingleProcess (0 steps after its spawn), and any other spawned thread
+  ///   executes its first step at the next SingleProcess (1 step after its spawn), unless it is
+  ///   displaced by higher-priority threads (see GetMaxSpawnLatency).
+  /// NOTE: only available with a configurable scheduler policy (see SCHEDULER_T).
+  void SetFairShareScheduling(bool use=true) {
+    emp_assert(SCHED_CONFIGURABLE || !use, "Fair-share scheduling requires a configurable scheduler policy.");
+    if constexpr (SCHED_CONFIGURABLE) use_fair_share = use;
+  }
+
+  size_t GetFairShareMaxQuantum() const { return fair_share_max_quantum; }
+
+  /// Set the maximum number of execution steps a thread can take per SingleProcess in fair-share
+  /// mode (default: 64).
+  void SetFairShareMaxQuantum(size_t quantum) {
+    emp_assert(quantum > 0, "Fair-share max quantum must be > 0.");
+    fair_share_max_quantum = quantum;
+  }
+
+  /// Get the longest time (in steps) between any thread's spawn and its first execution step since
+  /// the last hardware reset (see GetNumSteps).
+  size_t GetMaxSpawnLatency() const { return max_spawn_latency; }
+
+  bool IsExecStateRecyclingUsed() const { return threads.IsExecStateRecyclingUsed(); }
+
+  /// Should threads' execution states be recycled rather than reset when threads are reclaimed
+  /// (see sched::ThreadTable::SetExecStateRecycling)? With recycling, a reused thread keeps the
+  /// storage its previous execution state allocated, so steady-state thread churn does not need to
+  /// reallocate it. Requires EXEC_STATE_T::Recycle().
+  void SetExecStateRecycling(bool recycle=true) { threads.SetExecStateRecycling(recycle); }
+
+  bool IsParallelExecutionUsed() const { return (bool)worker_pool; }
+
+  /// Get the number of OS threads that execute this hardware's threads (1 => serial execution).
+  size_t GetNumParallelWorkers() const { return worker_pool ? worker_pool->GetNumThreads() : 1; }
+
+  /// Opt in to parallel execution with the given number of OS threads (num_workers <= 1 turns
+  /// parallel execution off). Requires DERIVED_T::IsThreadLocalStep (see REQUIREMENTS).
+  /// In parallel mode, each SingleProcess first executes every running thread ahead, in parallel,
+  /// for as long as its steps are thread-local (and within its quantum). Then, threads finish
+  /// their turns one at a time, in execution order, exactly as they would in serial mode; so,
+  /// all steps that touch shared state (e.g., global memory, spawns, events) happen in serial
+  /// order, and results are identical to serial execution, provided that:
+  /// - thread-local steps really only touch their own thread's state (including any callbacks
+  ///   they trigger, e.g., before-instruction signals; so, e.g., LinearProgramCPU's flow
+  ///   instructions are only thread-local with its default flow handlers, and installing custom
+  ///   ones is asserted against in parallel mode), and
+  /// - while executing, threads do not kill or block *other* running threads or change scheduler
+  ///   settings. (A thread that already executed ahead cannot be killed or blocked until its turn
+  ///   is finished: KillActiveThread and BlockThread return false for it.)
+  /// Parallel execution pays off when threads take many thread-local steps per SingleProcess
+  /// (e.g., with a thread quantum > 1); copies of this hardware share its worker threads.
+  void SetParallelExecution(size_t num_workers) {
+    emp_assert(!is_executing, "Cannot change execution mode while executing.");
+    if (num_workers <= 1) {
+      worker_pool.reset();
+      return;
+    }
+    if constexpr (decltype(DetectIsThreadLocalStep<DERIVED_T>(0))::value) {
+      worker_pool = std::make_shared<sched::WorkerPool>(num_workers);
+    } else {
+      emp_assert(false, "Parallel execution requires DERIVED_T::IsThreadLocalStep.");
+    }
+  }
+
+  /// Save this hardware's state: BaseCPU's state (see BaseState) and, if DERIVED_T defines
+  /// snapshot_t (see REQUIREMENTS), DERIVED_T's. Restore the saved state with Restore (e.g., to run
+  /// many trials from the same warmed-up state). Snapshots do not include the hardware's
+  /// configuration outside of the scheduler (e.g., its program, instruction and event libraries,
+  /// or execution mode).
+  template<typename HW_T=DERIVED_T>
+  typename SnapshotType<HW_T>::type Snapshot() const {
+    typename SnapshotType<HW_T>::type snapshot;
+    Snapshot(snapshot);
+    return snapshot;
+  }
+
+  /// Save this hardware's state into the given (existing) snapshot, reusing its storage.
+  template<typename SNAPSHOT_T>
+  void Snapshot(SNAPSHOT_T& snapshot) const {
+    static_assert(std::is_base_of<BaseState, SNAPSHOT_T>::value, "Snapshot type must derive from BaseState.");
+    emp_assert(!is_executing, "Cannot snapshot hardware while executing.");
+    CopyBaseState(*this, static_cast<BaseState&>(snapshot));
+    if constexpr (decltype(DetectSaveState<DERIVED_T, SNAPSHOT_T>(0))::value) {
+      GetHardware().SaveState(snapshot);
+    }
+  }
+
+  /// Restore hardware state saved by Snapshot. State is copied into the hardware's existing storage
+  /// (so restoring does not allocate once storage has grown to fit), and nothing is recompiled:
+  /// the hardware must have the same configuration (e.g., program) as when the snapshot was taken.
+  template<typename SNAPSHOT_T>
+  void Restore(const SNAPSHOT_T& snapshot) {
+    static_assert(std::is_base_of<BaseState, SNAPSHOT_T>::value, "Snapshot type must derive from BaseState.");
+    emp_assert(!is_executing, "Cannot restore hardware while executing.");
+    CopyBaseState(static_cast<const BaseState&>(snapshot), *this);
+    thread_exec_order_cache_version = (size_t)-1;
+    if constexpr (decltype(DetectRestoreState<DERIVED_T, SNAPSHOT_T>(0))::value) {
+      GetHardware().RestoreState(snapshot);
+    }
+  }
+
+  bool IsCycleDetectionUsed() const { return use_cycle_detection; }
+
+  /// Should this hardware watch for state cycles? Evolved programs often get stuck revisiting the
+  /// same states (e.g., in while loops that never change memory, or in circular calls); from then
+  /// on, they do no useful work. With cycle detection on, after every check_interval steps, the
+  /// hardware hashes its state (see GetStateHash) and checks whether a previously checked state
+  /// has recurred (see sched::CycleDetector; checking is O(1) beyond hashing). States are only
+  /// checked while no events are queued or scheduled (events can change future execution) and
+  /// while there is something to run: an idle hardware, or one whose threads are all blocked, is
+  /// waiting rather than livelocked, so it is never halted.
+  /// Requires that DERIVED_T can hash its state (see REQUIREMENTS).
+  /// NOTE: detection assumes that execution only depends on the hashed state. It may report false
+  ///       recurrences if instructions use random numbers, if the custom component affects
+  ///       execution, or if the hardware is modified between steps (see ResetCycleDetection), and
+  ///       (rarely) on hash collisions.
+  void SetCycleDetection(bool use, size_t check_interval=1) {
+    emp_assert(check_interval > 0, "Cycle check interval must be > 0.");
+    emp_assert(!use || decltype(DetectHashState<DERIVED_T>(0))::value,
+      "Cycle detection requires DERIVED_T to implement HashState and HashExecState.");
+    use_cycle_detection = use;
+    cycle_check_interval = check_interval;
+    ResetCycleDetection();
+  }
+
+  bool IsHaltOnCycleUsed() const { return halt_on_cycle; }
+
+  /// Should this hardware halt when cycle detection (see SetCycleDetection) finds a state cycle?
+  /// A halted hardware ignores SingleProcess calls (and ProcessFor and ProcessUntilIdle return
+  /// right away) until ResetCycleDetection or Reset is called.
+  void SetHaltOnCycle(bool halt) { halt_on_cycle = halt; }
+
+  /// Has cycle detection found a state cycle?
+  bool IsCycleDetected() const { return cycle_detector.IsCycleDetected(); }
+
+  /// Get the length (in steps) of the detected state cycle (0 if none has been detected).
+  size_t GetCycleLength() const { return cycle_detector.GetCycleLength() * cycle_check_interval; }
+
+  /// Is the hardware halted on a state cycle (see SetHaltOnCycle)?
+  bool IsHalted() const { return is_halted; }
+
+  /// Forget previously checked states (and any detected cycle), and resume a halted hardware.
+  /// Call after modifying the hardware between steps (e.g., writing memory). Spawning threads and
+  /// queueing events between steps do this automatically.
+  void ResetCycleDetection() {
+    cycle_detector.Reset();
+    is_halted = false;
+  }
+
+  /// Get a hash of the hardware state that future execution depends on: the hardware-wide state
+  /// (see DERIVED_T::HashState), active threads (in execution order), pending and woken threads
+  /// (in queue order), blocked threads (and their wait lists), and unused thread ids (in reuse
+  /// order).
+  /// Each thread contributes its id, run state, priority, and execution state. Counters (e.g.,
+  /// the step count) are not included.
+  size_t GetStateHash() const {
+    static_assert(decltype(DetectHashState<DERIVED_T>(0))::value,
+      "GetStateHash requires DERIVED_T to implement HashState and HashExecState.");
+    constexpr size_t SEPARATOR = std::numeric_limits<size_t>::max();
+    size_t hash = GetHardware().HashState();
+    for (size_t id : thread_exec_order) hash = HashThread(hash, id);
+    hash = utils::HashCombine(hash, SEPARATOR);
+    for (size_t id : pending_threads) hash = HashThread(hash, id);
+    hash = utils::HashCombine(hash, SEPARATOR);
+    for (size_t id : woken_threads) hash = HashThread(hash, id);
+    hash = utils::HashCombine(hash, SEPARATOR);
+    if (!blocked_threads.empty()) {
+      for (size_t id = 0; id < threads.size(); ++id) {
+        if (!blocked_threads.Has(id)) continue;
+        hash = utils::HashCombine(hash, id);
+        hash = utils::HashCombine(hash, blocked_threads.GetKey(id));
+        hash = utils::HashCombine(hash, blocked_threads.Next(id));
+        if (!active_threads.Has(id)) hash = HashThread(hash, id);
+      }
+    }
+    hash = utils::HashCombine(hash, SEPARATOR);
+    for (size_t id : unused_threads) hash = utils::HashCombine(hash, id);
+    return hash;
+  }
+
+  bool IsSpawnAdmissionControlUsed() const { return use_spawn_admission_control; }
+
+  /// Should this hardware reject spawn requests that cannot win an active thread slot (see
+  /// IsSpawnAdmissible)? Rejected requests do not claim a thread slot or displace a pending thread.
+  void SetSpawnAdmissionControlUse(bool use_admission=true) { use_spawn_admission_control = use_admission; }
+
+  /// Could a thread spawned now at the given priority win an active thread slot at the next
+  /// activation? This check assumes that currently active threads remain active, and it is
+  /// conservative: it only returns false if the thread would certainly lose (O(1)), with one
+  /// exception. Threads marked dead or blocked but not yet removed by SingleProcess (see
+  /// KillActiveThread and BlockThread) still count as active here, though some of them are removed
+  /// before the next activation; so a spawn that could win a slot they free up may be rejected.
+  /// - Free active slots go to woken threads (see WakeThread) first.
+  /// - Without thread priority, pending threads are activated first-come-first-served, so there
+  ///   must be a free active slot not already claimed by a pending or woken thread.
+  /// - With thread priority, the thread must either outrank the lowest-priority active thread or
+  ///   there must be a free active slot that is not certain to go to a higher-priority pending
+  ///   thread.
+  bool IsSpawnAdmissible(double priority) const {
+    // Woken threads take free slots first; while any of them waits, no pending thread is activated.
+    const size_t num_claimed = active_threads.size() + woken_threads.size();
+    if (num_claimed > max_active_threads) return false;
+    const size_t free_slots = max_active_threads - num_claimed;
+    if (pending_threads.size() < free_slots) return true;
+    if (!IsThreadPriorityUsed()) return false;
+    const double sched_priority = GetSchedPriority(priority);
+    if (GetNumIndexedActive() && sched_priority > GetThreadSchedPriority(PeekMinActive())) return true;
+    // All free slots (if any) go to pending threads; only okay if some pending thread doesn't outrank us.
+    return free_slots && GetThreadSchedPriority(PeekMinPending()) <= sched_priority;
+  }
+
+  /// Set the priority of the specified thread, updating thread scheduling structures if the
+  /// thread is PENDING or RUNNING. Safe to call while the hardware is executing.
+  void SetThreadPriority(size_t thread_id, double priority) {
+    emp_assert(thread_id < threads.size(), "Thread ID is invalid.", thread_id);
+    threads.SetPriority(thread_id, priority);
+    ReindexPriority(thread_id);
+  }
+
+  /// Get the number of integer priority levels used in priority-bucket mode (0 if priority-bucket
+  /// mode is off).
+  size_t GetNumPriorityLevels() const { return num_priority_levels; }
+
+  /// Get the priority level of the given priority in priority-bucket mode: floor(priority),
+  /// clamped to [0:num_levels).
+  size_t GetPriorityLevel(double priority) const {
+    emp_assert(num_priority_levels);
+    if (!(priority > 0)) return 0;
+    if (priority >= (double)(num_priority_levels - 1)) return num_priority_levels - 1;
+    return (size_t)priority;
+  }
+
+  /// Opt in to (or out of, with num_levels=0) priority-bucket mode. In priority-bucket mode,
+  /// scheduling decisions compare priority levels (see GetPriorityLevel) instead of raw priorities,
+  /// and threads are tracked in per-level queues, making activation decisions O(1) per thread
+  /// rather than O(log n). Threads at the same level are ordered by arrival. Intended for
+  /// applications where thread priorities come from a small set of integer values.
+  /// Cannot change while the hardware is executing.
+  /// NOTE: fixed by non-configurable scheduler policies (see SCHEDULER_T).
+  void SetNumPriorityLevels(size_t num_levels) {
+    emp_assert(!is_executing, "Cannot change scheduler mode while executing.");
+    emp_assert(num_levels <= sched::PriorityBuckets::MAX_LEVELS, num_levels);
+    emp_assert(SCHED_CONFIGURABLE || num_levels == scheduler_t::NUM_PRIORITY_LEVELS,
+      "Number of priority levels is fixed by the scheduler policy.");
+    if constexpr (!SCHED_CONFIGURABLE) return;
+    // Rebuild the priority index.
+    pending_priorities_MAX.Clear();
+    pending_priorities_MIN.Clear();
+    active_priorities_MIN.Clear();
+    num_priority_levels = num_levels;
+    if (num_levels) {
+      pending_buckets.SetNumLevels(num_levels);
+      active_buckets.SetNumLevels(num_levels);
+    } else {
+      pending_buckets.Clear();
+      active_buckets.Clear();
+    }
+    for (size_t id : thread_exec_order) IndexActivePriority(id);
+    for (size_t id : pending_threads) IndexPendingPriority(id);
+  }
 
   /// TODO - TEST
   /// Set this hardware's active thread limit (i.e., the maximum number of threads that can be running
@@ -457,6 +1411,8 @@ public:
   ///       the hardware's active thread limit during initial hardware configuration.
   /// Warning: If you decrease max threads, you may kill actively running threads.
   /// Warning: This is a slow operation.
+  /// NOTE: must not be called while a step is paused (see IsStepInProgress).
+  /// NOTE: fixed by fixed-capacity scheduler policies (see sched::FixedCapacity).
   void SetActiveThreadLimit(size_t n);
 
   /// TODO - test!
@@ -467,6 +1423,9 @@ public:
   ///       the hardware's thread capacity during initial hardware configuration.
   /// Warning: If you decrease the maximum capacity, you may kill actively running threads.
   /// Warning: This is a slow operation.
+  /// NOTE: must not be called while a step is paused (see IsStepInProgress); shrinking thread
+  ///       storage could drop the thread that the step resumes with.
+  /// NOTE: fixed by fixed-capacity scheduler policies (see sched::FixedCapacity).
   void SetThreadCapacity(size_t n);
 
   /// @discussion - Better name?
@@ -475,16 +1434,21 @@ public:
 
   /// Kill a thread specified by the thread id.
   /// if executing: mark as dead
+  /// @return false if the thread is not running, or if it executed ahead in parallel and has not
+  ///         finished its turn yet (see SetParallelExecution).
   bool KillActiveThread(size_t thread_id) {
     emp_assert(thread_id < threads.size(), "Thread ID is invalid.");
-    auto& thread = GetThread(thread_id);
-    if (!thread.IsRunning()) return false;
+    if (IsThreadAhead(thread_id)) return false;
+    // Check run state before building a handle (a pending thread's deferred initialization is
+    // never needed here).
+    if (threads.GetRunState(thread_id) != thread_state_t::RUNNING) return false;
     // If hardware is executing, mark thread as dead. Let SingleProcess actually kill the thread.
     // Otherwise, assert the thread is in active threads and actually kill the thread.
     if (is_executing) {
-      thread.SetDead();
+      threads[thread_id].SetDead();
+      ++thread_change_cnt;
     } else {
-      emp_assert(emp::Has(active_threads, thread_id), "thread_id not found in active threads", thread_id);
+      emp_assert(active_threads.Has(thread_id), "thread_id not found in active threads", thread_id);
       KillActiveThread_impl(thread_id);
     }
     return true;
@@ -496,16 +1460,143 @@ public:
   bool KillCurThread() {
     emp_assert(is_executing, "Hardware is not executing! No current thread.");
     emp_assert(cur_thread.IsValid(), "There is no currently executing thread.");
-    emp_assert(cur_thread.ID() < threads.size(), "Current thread ID is invalid.");
+    emp_assert(GetCurThreadID_impl() < threads.size(), "Current thread ID is invalid.");
     // Is current thread in active threads?
     if (!is_executing) return false;
     // Mark this thread as dead (let SingleProcess clean it up)
     // If we were to kill it outright, we could run into edge-case side effects where it gets reclaimed
     // as a pending thread, which would reset it and potentially invalidate important references.
-    GetCurThreadID().SetDead();
+    threads.SetRunState(GetCurThreadID(), thread_state_t::DEAD);
     return true;
   }
 
+  /// Block a running thread until it is woken (see WakeThreads) using the given wait key.
+  /// A blocked thread keeps its execution state but stops executing, and once parked, it no
+  /// longer occupies an active thread slot. Threads are parked by SingleProcess (when it next
+  /// reaches the thread in the execution order), so it is safe to block the currently executing
+  /// thread (e.g., from an instruction).
+  /// By default, threads blocked on key k are woken whenever an event with id k is handled.
+  /// @return false if the thread is not running, or if it executed ahead in parallel and has not
+  ///         finished its turn yet (see SetParallelExecution).
+  bool BlockThread(size_t thread_id, size_t wait_key) {
+    emp_assert(thread_id < threads.size(), "Thread ID is invalid.");
+    if (IsThreadAhead(thread_id)) return false;
+    if (threads.GetRunState(thread_id) != thread_state_t::RUNNING) return false;
+    emp_assert(active_threads.Has(thread_id), "thread_id not found in active threads", thread_id);
+    threads.SetRunState(thread_id, thread_state_t::BLOCKED);
+    blocked_threads.Insert(thread_id, wait_key);
+    return true;
+  }
+
+  /// Block the currently executing thread until it is woken using the given wait key.
+  /// The thread yields the remainder of its quantum.
+  bool BlockCurThread(size_t wait_key) {
+    emp_assert(is_executing, "Hardware is not executing! No current thread.");
+    return BlockThread(GetCurThreadID(), wait_key);
+  }
+
+  /// Get the wait key for tag-based waits on the given tag: tags are keyed on the module that best
+  /// matches them (see FindBestModuleMatch), so a waiting thread is woken by any tag that matches
+  /// the same module (see WakeThreadsWithTag).
+  /// @return Wait key (no value if no module matches the tag).
+  std::optional<size_t> GetTagWaitKey(const tag_t& tag) {
+    const std::optional<module_id_t> match(FindBestModuleMatch(tag));
+    if (!match) return std::nullopt;
+    return TAG_WAIT_KEY_FLAG | *match;
+  }
+
+  /// Block a running thread until it is woken by a tag that matches the same module as the given
+  /// tag (see GetTagWaitKey and WakeThreadsWithTag).
+  /// @return false if the thread is not running (see BlockThread) or no module matches the tag.
+  bool BlockThreadOnTag(size_t thread_id, const tag_t& tag) {
+    const std::optional<size_t> wait_key(GetTagWaitKey(tag));
+    return wait_key && BlockThread(thread_id, *wait_key);
+  }
+
+  /// Block the currently executing thread until it is woken by a matching tag (see
+  /// BlockThreadOnTag). The thread yields the remainder of its quantum.
+  bool BlockCurThreadOnTag(const tag_t& tag) {
+    emp_assert(is_executing, "Hardware is not executing! No current thread.");
+    return BlockThreadOnTag(GetCurThreadID(), tag);
+  }
+
+  /// Wake the specified blocked thread. A parked thread resumes at the next SingleProcess, taking
+  /// a free active slot ahead of any pending (newly spawned) thread. If there is no free slot, it
+  /// stays parked until one frees up (woken threads never displace active threads, and pending
+  /// threads are not activated while woken threads wait).
+  /// @return false if the thread is not blocked.
+  bool WakeThread(size_t thread_id) {
+    if (!blocked_threads.Has(thread_id)) return false;
+    WakeThread_impl(thread_id);
+    return true;
+  }
+
+  /// Wake all threads blocked on the given wait key (in the order they were blocked).
+  /// Cost is proportional to the number of threads woken (there is no scan over threads).
+  /// @return Number of threads woken.
+  size_t WakeThreads(size_t wait_key) {
+    size_t num_woken = 0;
+    for (size_t id = blocked_threads.Front(wait_key); id != sched::WaitLists::npos; id = blocked_threads.Front(wait_key)) {
+      WakeThread_impl(id);
+      ++num_woken;
+    }
+    return num_woken;
+  }
+
+  /// Wake all threads blocked on a tag that matches the same module as the given tag (see
+  /// BlockThreadOnTag), in the order they were blocked.
+  /// @return Number of threads woken.
+  size_t WakeThreadsWithTag(const tag_t& tag) {
+    if (blocked_threads.empty()) return 0;
+    const std::optional<size_t> wait_key(GetTagWaitKey(tag));
+    return wait_key ? WakeThreads(*wait_key) : 0;
+  }
+
+  /// Kill a blocked thread.
+  /// @return false if the thread is not blocked.
+  bool KillBlockedThread(size_t thread_id) {
+    if (!blocked_threads.Has(thread_id)) return false;
+    if (active_threads.Has(thread_id)) {
+      // Not parked yet; kill as an active thread.
+      if (is_executing) {
+        blocked_threads.Remove(thread_id);
+        threads.SetRunState(thread_id, thread_state_t::DEAD);
+        ++thread_change_cnt;
+      } else {
+        KillActiveThread_impl(thread_id);
+      }
+    } else {
+      emp_assert(thread_membership.Check(thread_id, membership_t::PARKED), "Thread ID not tracked as parked", thread_id);
+      blocked_threads.Remove(thread_id);
+      threads.SetRunState(thread_id, thread_state_t::DEAD);
+      unused_threads.emplace_back(thread_id);
+      thread_membership.Set(thread_id, membership_t::UNUSED);
+    }
+    return true;
+  }
+
+  /// Find up to n modules that match the given tag, writing their ids into matches (cleared
+  /// first). Does not allocate (beyond growing matches) if DERIVED_T provides
+  /// FindModuleMatch(tag, n, matches) (see REQUIREMENTS); otherwise, copies the result of
+  /// FindModuleMatch(tag, n) into matches (keeping matches' storage).
+  void FindModuleMatches(const tag_t& tag, size_t n, emp::vector<module_id_t>& matches) {
+    if constexpr (decltype(DetectFindModuleMatchInto<DERIVED_T>(0))::value) {
+      matches.clear();
+      GetHardware().FindModuleMatch(tag, n, matches);
+    } else {
+      const auto result = GetHardware().FindModuleMatch(tag, n);
+      matches.assign(result.begin(), result.end());
+    }
+  }
+
+  /// Find the module that best matches the given tag (using a reusable internal buffer).
+  /// @return Matching module id (no value if no module matches).
+  std::optional<module_id_t> FindBestModuleMatch(const tag_t& tag) {
+    FindModuleMatches(tag, 1, module_matches);
+    if (module_matches.empty()) return std::nullopt;
+    return module_matches[0];
+  }
+
   /// Request that up to n threads are spawned using the given tag at the given priority.
   /// All spawned threads will be marked as pending until the next SingleProcess where they will
   /// have the chance to run.
@@ -517,18 +1608,52 @@ public:
   /// @return A vector of thread IDs that were 'spawned'.
   emp::vector<size_t> SpawnThreads(const tag_t& tag, size_t n, double priority=1.0);
 
-  std::optional<size_t> SpawnThreadWithTag(const tag_t& tag, double priority=1.0);
+  /// Same as above, but also reports the result of every spawn request (one per matching module)
+  /// in results (cleared first). Use to apply back-pressure on rejected spawns.
+  emp::vector<size_t> SpawnThreads(
+    const tag_t& tag,
+    size_t n,
+    double priority,
+    emp::vector<spawn_result_t>& results
+  );
+
+  /// Same as SpawnThreads(tag, n, priority), but writes the ids of spawned threads into
+  /// thread_ids (cleared first). Does not allocate once thread_ids (and thread storage) have grown
+  /// to size (see FindModuleMatches).
+  void SpawnThreads(
+    const tag_t& tag,
+    size_t n,
+    double priority,
+    emp::vector<size_t>& thread_ids
+  );
+
+  /// Spawn a new thread using the module that best matches the given tag.
+  /// @return Spawn result (REJECTED_NO_MATCH if no module matched the tag).
+  spawn_result_t SpawnThreadWithTag(const tag_t& tag, double priority=1.0);
 
   /// Spawn a new thread with given ID.
-  /// If no unused threads & already maxed out thread space, will not spawn new
-  /// thread.
+  /// If admission control is on and the thread could not win an active slot, will not spawn a new
+  /// thread (REJECTED_PRIORITY; or REJECTED_NO_SPACE without thread priority, where the thread
+  /// was rejected for lack of a free active slot).
+  /// If no unused threads & already maxed out thread space, will not spawn new thread unless it
+  /// can replace a lower-priority pending thread (REJECTED_NO_SPACE).
   /// Otherwise, mark thread as pending.
-  /// @return Thread id of spawned thread (if a thread was successfully spawned)
-  std::optional<size_t> SpawnThreadWithID(module_id_t module_id, double priority=1.0);
-
-  /// Handle an event (on this hardware) now!
+  /// @return Spawn result: thread id of spawned thread (if a thread was successfully spawned)
+  ///         and the outcome of the request.
+  spawn_result_t SpawnThreadWithID(module_id_t module_id, double priority=1.0);
+
+  /// Handle an event (on this hardware) now! Wakes any threads blocked on the event's id and, if
+  /// EVENT_T has a tag (GetTag()), any threads blocked on a matching tag (see WakeThreadsWithTag).
+  /// NOTE: queued events are handled as event_t (BaseEvent), so their handlers must wake tag-based
+  /// waits themselves (by calling WakeThreadsWithTag), if the event has a tag.
   template<typename EVENT_T>
-  void HandleEvent(const EVENT_T& event) { event_lib.HandleEvent(GetHardware(), event); }
+  void HandleEvent(const EVENT_T& event) {
+    event_lib.HandleEvent(GetHardware(), event);
+    if (!blocked_threads.empty()) WakeThreads(event.GetID());
+    if constexpr (decltype(DetectEventTag<EVENT_T>(0))::value) {
+      WakeThreadsWithTag(event.GetTag());
+    }
+  }
 
   /// Trigger an event (from this hardware).
   template<typename EVENT_T>
@@ -538,11 +1663,34 @@ public:
   /// unit is executed.
   template<typename EVENT_T>
   void QueueEvent(const EVENT_T& event) {
-    event_queue.emplace_back(std::make_shared<EVENT_T>(event));
+    OnExternalChange();
+    event_queue.PushBack(std::make_shared<EVENT_T>(event));
   }
 
-  /// Advance the hardware by a single step.
-  void SingleProcess();
+  /// Queue an event to be handled by the SingleProcess call made when GetNumSteps() == step.
+  /// Events scheduled for a step that has already started are handled at the next SingleProcess.
+  /// Scheduling is O(1), and events scheduled far in the future cost nothing per step.
+  template<typename EVENT_T>
+  void QueueEventAt(const EVENT_T& event, size_t step) {
+    OnExternalChange();
+    event_wheel.Insert(step, std::make_shared<EVENT_T>(event));
+  }
+
+  /// Queue an event to be handled delay steps from now. QueueEventIn(event, 0) is equivalent to
+  /// QueueEvent(event), QueueEventIn(event, 1) delivers the event one SingleProcess later, etc.
+  template<typename EVENT_T>
+  void QueueEventIn(const EVENT_T& event, size_t delay) {
+    QueueEventAt(event, GetNumSteps() + delay);
+  }
+
+  /// Advance the hardware by a single step. If the current step was paused (see ProcessFor),
+  /// finish it instead.
+  void SingleProcess() {
+    if (is_halted) return;
+    constexpr auto never_pause = []() { return false; };
+    SingleProcess_impl(never_pause);
+    if (use_cycle_detection) CheckForCycle();
+  }
 
   /// Advance hardware by some arbitrary number of steps.
   void Process(size_t num_steps) {
@@ -551,6 +1699,38 @@ public:
     }
   }
 
+  /// Advance hardware until the given budget (see sched::ProcessBudget) is used up, or until the
+  /// hardware is idle. Unlike step counts, instruction and wall-clock budgets track the actual cost
+  /// of execution (a step with many active threads costs more than a step with one).
+  /// Budgets are checked between threads' turns: if the budget runs out partway through a step,
+  /// the step pauses (see IsStepInProgress) before the next thread's turn, and the next
+  /// SingleProcess or ProcessFor call resumes it there. So, the hardware follows the same
+  /// trajectory no matter how its execution is split across calls, and a thread's turn is never
+  /// split; the instruction budget may be exceeded by up to one thread's quantum. In parallel
+  /// execution mode, budgets are only checked between steps.
+  /// @return What was consumed (see sched::ProcessResult).
+  process_result_t ProcessFor(const process_budget_t& budget);
+
+  /// Is the hardware idle (i.e., no active threads, no pending or woken threads, and no queued or
+  /// scheduled events)? An idle hardware unit will not change state on SingleProcess (other than
+  /// advancing its step count).
+  bool IsIdle() const {
+    return active_threads.empty() && pending_threads.empty() && woken_threads.empty()
+      && event_queue.empty() && event_wheel.empty();
+  }
+
+  /// Advance hardware until it is idle (see IsIdle) or halted (see SetHaltOnCycle), or until
+  /// max_steps steps have been taken, whichever comes first.
+  /// @return Number of steps actually taken.
+  size_t ProcessUntilIdle(size_t max_steps) {
+    size_t num_steps = 0;
+    while (num_steps < max_steps && !IsIdle() && !is_halted) {
+      SingleProcess();
+      ++num_steps;
+    }
+    return num_steps;
+  }
+
   /// How does the hardware state get printed?
   void SetPrintHardwareStateFun(const fun_print_hardware_state_t& print_fun) {
     fun_print_hardware_state = print_fun;
@@ -569,9 +1749,8 @@ public:
   /// Print active threads.
   void PrintActiveThreadStates(std::ostream& os=std::cout) const {
     for (size_t thread_id : active_threads) {
-      const thread_t & thread = threads[thread_id];
       os << "Thread ID = " << thread_id << "):\n";
-      PrintExecutionState(thread.GetExecState(), GetHardware(), os);
+      fun_print_execution_state(threads.GetExecState(thread_id), GetHardware(), os);
       os << "\n";
     }
   }
@@ -587,7 +1766,7 @@ public:
     os << "Event queue (" << event_queue.size() << "): [";
     for (size_t i = 0; i < event_queue.size(); ++i) {
       if (i) os << ", ";
-      fun_print_event(event_queue[i], GetHardware(), os);
+      fun_print_event(*event_queue[i], GetHardware(), os);
     }
     os << "]";
   }
@@ -604,126 +1783,135 @@ template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::ActivatePendingThreads() {
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::ActivatePendingThreads() {
   emp_assert(!is_executing, "Cannot ActivatePendingThreads while hardware is executing.");
   // emp_assert(ValidateThreadState()); => Slow!
   // NOTE: Assumes active threads is accurate!
   // NOTE: all pending threads + active threads should have unique ids
 
+  // Woken threads take free slots first.
+  ResumeWokenThreads();
+
   // Are there pending threads to activate? If not, return immediately.
   if (pending_threads.empty()) return;
 
+  // Pending threads are not activated (and so, do not displace active threads) while woken
+  // threads are still waiting for a slot.
+  if (!woken_threads.empty()) {
+    while (pending_threads.size()) KillNextPendingThread();
+    return;
+  }
+
   // If configuration says no thread priority or if num pending + num active < max active, just
   // activate all pending; otherwise, take priorities into consideration.
-  if (!use_thread_priority || ((pending_threads.size() + active_threads.size()) < max_active_threads)) {
-    // Don't use thread priority for deciding which pending threads to activate.
-    // In effect, all actively running threads will have higher priority than all pending threads.
-    // I.e., no actively running threads will be killed to make space for pending threads.
-
-    // Spawn pending threads (in order of arrival) until no more room.
-    while (pending_threads.size() && (active_threads.size() < max_active_threads)) {
-      const size_t thread_id = pending_threads.front();
-      emp_assert(thread_id < threads.size(), "Invalid pending thread id", thread_id);
-      emp_assert(threads[thread_id].IsPending(), "Non-pending thread masquarading as a pending thread!");
-      ActivateThread(thread_id);  // todo - should this be Activate next pending?
-      pending_threads.pop_front();
+  if constexpr (SCHED_INDEXES_PRIORITY) {
+    if (IsThreadPriorityUsed() && ((pending_threads.size() + active_threads.size()) >= max_active_threads)) {
+      ActivatePendingThreads_UsePriority_impl();
+    } else {
+      ActivatePendingThreads_NoPriority_impl();
     }
-
   } else {
-    // std::cout << "Making use of thread priority for activating pending." << std::endl;
-    // Use Thread priority for deciding which threads to activate:
-    // - (1) Order pending threads by max priority.
-    // - (2) Order active threads by min priority (only those < max pending).
-    // - (3) For each pending thread (while pending.max > active.min), activate pending.
-
-    // (1) Order pending threads by max priority (MAX heap).
-    //     + find max pending priority, use to bound which active threads we consider killing.
-    std::priority_queue<std::tuple<double, size_t>,
-                        std::vector<std::tuple<double, size_t>>> pending_priorities_MAX; // MAX HEAP
-    double max_pending_priority = threads[pending_threads.front()].GetPriority();
-    for (size_t pending_id : pending_threads) {
-      emp_assert(pending_id < threads.size());
-      emp_assert(threads[pending_id].IsPending());
-      const double priority = threads[pending_id].GetPriority();
-      pending_priorities_MAX.emplace(std::make_tuple(priority, pending_id));
-      if (priority > max_pending_priority) max_pending_priority = priority;
-    }
-
-    // (2) Order active threads (priority < max pending) by min priority (MIN heap).
-    //     Only include threads with priority < max_pending_priority
-    std::priority_queue<std::tuple<double, size_t>,
-                        std::vector<std::tuple<double, size_t>>,
-                        std::greater<std::tuple<double, size_t>>> active_priorities_MIN; // MIN heap.
-    for (size_t active_id : active_threads) {
-      emp_assert(active_id < threads.size());
-      thread_t & thread = threads[active_id];
-      if (thread.GetPriority() < max_pending_priority) {
-        active_priorities_MIN.emplace(std::make_tuple(thread.GetPriority(), active_id));
-      }
-    }
-
-    // (3) For each pending thread (while pending.max > active.min), activate pending.
-    // - Because we can't efficiently remove elements from the pending queue, track which pending
-    //   ids we want to spawn and which we don't.
+    ActivatePendingThreads_NoPriority_impl();
+  }
+  // Are there remaining threads we need to clean up?
+  while (pending_threads.size()) {
+    KillNextPendingThread();
+  }
+  // emp_assert(ValidateThreadState()); this is real slow
+}
 
-    // Map from each pending thread we want to activate to the active thread it will replace.
-    std::unordered_map<size_t, std::pair<bool, size_t>> pending_to_active;
+template<
+  typename DERIVED_T,
+  typename EXEC_STATE_T,
+  typename TAG_T,
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
+>
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::ActivatePendingThreads_NoPriority_impl() {
+  // Don't use thread priority for deciding which pending threads to activate.
+  // In effect, all actively running threads will have higher priority than all pending threads.
+  // I.e., no actively running threads will be killed to make space for pending threads.
+
+  // Spawn pending threads (in order of arrival) until no more room.
+  while (pending_threads.size() && (active_threads.size() < max_active_threads)) {
+    const size_t thread_id = pending_threads.Front();
+    emp_assert(thread_id < threads.size(), "Invalid pending thread id", thread_id);
+    emp_assert(threads.GetRunState(thread_id) == thread_state_t::PENDING, "Non-pending thread masquarading as a pending thread!");
+    ActivateThread(thread_id);  // todo - should this be Activate next pending?
+    pending_threads.PopFront();
+    UnindexPendingPriority(thread_id);
+  }
+}
 
-    // First, mark as many pending threads (in max priority order) to be set to active as there is
-    // space.
-    while (((pending_to_active.size() + active_threads.size()) < max_active_threads) && pending_priorities_MAX.size()) {
-      const size_t pending_id_MAX = std::get<1>(pending_priorities_MAX.top());
-      pending_to_active.emplace(pending_id_MAX, std::make_pair(false, max_thread_space));
-      pending_priorities_MAX.pop();
-    }
+template<
+  typename DERIVED_T,
+  typename EXEC_STATE_T,
+  typename TAG_T,
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
+>
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::ActivatePendingThreads_UsePriority_impl() {
+  // std::cout << "Making use of thread priority for activating pending." << std::endl;
+  // Use Thread priority for deciding which threads to activate:
+  // - (1) Pending threads are ordered by max priority (pending_priorities_MAX or pending_buckets).
+  // - (2) Active threads are ordered by min priority (active_priorities_MIN or active_buckets).
+  // - (3) For each pending thread (while pending.max > active.min), activate pending.
+  // Both heaps are maintained as threads are spawned/activated/killed, so there is nothing to
+  // rebuild here. Every pending thread is resolved (activated or killed) by the end of this
+  // function, so it is safe to pop max-priority pending threads as we go. Popped min-priority
+  // active threads are always killed below.
+  emp_assert(GetNumIndexedPending() == pending_threads.size());
+
+  // (3) For each pending thread (while pending.max > active.min), activate pending.
+  // - Because we can't efficiently remove elements from the pending queue, track which pending
+  //   ids we want to spawn and which we don't (activation_markers maps each pending thread we
+  //   want to activate to the active thread it will replace).
+  size_t num_marked = 0;
+
+  // First, mark as many pending threads (in max priority order) to be set to active as there is
+  // space.
+  while (((num_marked + active_threads.size()) < max_active_threads) && GetNumIndexedPending()) {
+    activation_markers[PopMaxPending()] = ACTIVATE_NO_REPLACE;
+    ++num_marked;
+  }
 
-    // Are there any active thread_ids (+priorities) to consider killing?
-    // To activate any more pending threads, we will need to kill a currently active thread.
-    while (active_priorities_MIN.size() && pending_priorities_MAX.size()) {
-      const double pending_priority_MAX = std::get<0>(pending_priorities_MAX.top());
-      const double active_priority_MIN = std::get<0>(active_priorities_MIN.top());
-      if (pending_priority_MAX > active_priority_MIN) {
-        const size_t pending_id_MAX = std::get<1>(pending_priorities_MAX.top());
-        const size_t active_id_MIN = std::get<1>(active_priorities_MIN.top());
-        pending_to_active.emplace(pending_id_MAX, std::make_pair(true, active_id_MIN)); // Map current pending id to current active id.
-        pending_priorities_MAX.pop();
-        active_priorities_MIN.pop();
-      } else {
-        break; // If we ever hit a pending priority that is <= the min active priority, break.
-      }
+  // Are there any active thread_ids (+priorities) to consider killing?
+  // To activate any more pending threads, we will need to kill a currently active thread.
+  while (GetNumIndexedActive() && GetNumIndexedPending()) {
+    const double pending_priority_MAX = GetThreadSchedPriority(PeekMaxPending());
+    const double active_priority_MIN = GetThreadSchedPriority(PeekMinActive());
+    if (pending_priority_MAX > active_priority_MIN) {
+      const size_t pending_id_MAX = PopMaxPending();
+      const size_t active_id_MIN = PopMinActive();
+      activation_markers[pending_id_MAX] = active_id_MIN; // Map current pending id to current active id.
+    } else {
+      break; // If we ever hit a pending priority that is <= the min active priority, break.
     }
+  }
 
-    // For each pending thread, if we marked it to transition to active,
-    // activate it and kill associated active; otherwise, deny it (mark it as dead, move to unused).
-    // std::cout << "  Processing pending threads" << std::endl;
-    while (pending_threads.size()) {
-      const size_t pending_id = pending_threads.front();
-      // std::cout << "  > pending id=" << pending_id << std::endl;
-      if (emp::Has(pending_to_active, pending_id)) {
-        // std::cout << "    Should activate this pthread (" << threads[pending_id].GetPriority() << ")" << std::endl;
-        if (pending_to_active[pending_id].first) {
-          // Need to kill associated active.
-          const size_t active_id = pending_to_active[pending_id].second;
-          // std::cout << "    Need to first kill an active thread (" << active_id << std::endl;
-          KillActiveThread_impl(active_id);
-          // std::cout << "    Killed active." << std::endl;
-        }
-        // std::cout << "    Activate this thread now." << std::endl;
-        ActivateThread(pending_id);
-        pending_threads.pop_front();
-      } else {
-        // Kill this pending thread.
-        KillNextPendingThread();
+  // For each pending thread, if we marked it to transition to active,
+  // activate it and kill associated active; otherwise, deny it (mark it as dead, move to unused).
+  // std::cout << "  Processing pending threads" << std::endl;
+  while (pending_threads.size()) {
+    const size_t pending_id = pending_threads.Front();
+    const size_t marker = activation_markers[pending_id];
+    if (marker != NO_ACTIVATION) {
+      activation_markers[pending_id] = NO_ACTIVATION;
+      if (marker != ACTIVATE_NO_REPLACE) {
+        // Need to kill associated active.
+        KillActiveThread_impl(marker);
       }
+      ActivateThread(pending_id);
+      pending_threads.PopFront();
+      UnindexPendingPriority(pending_id);
+    } else {
+      // Kill this pending thread.
+      KillNextPendingThread();
     }
   }
-  // Are there remaining threads we need to clean up?
-  while (pending_threads.size()) {
-    KillNextPendingThread();
-  }
-  // emp_assert(ValidateThreadState()); this is real slow
 }
 
 
@@ -731,54 +1919,51 @@ template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::SetActiveThreadLimit_impl(
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::SetActiveThreadLimit_impl(
   size_t n
 ) {
-  if (use_thread_priority) SetActiveThreadLimit_UsePriority_impl(n);
-  else SetActiveThreadLimit_NoPriority_impl(n);
+  if constexpr (SCHED_INDEXES_PRIORITY) {
+    if (IsThreadPriorityUsed()) {
+      SetActiveThreadLimit_UsePriority_impl(n);
+      return;
+    }
+  }
+  SetActiveThreadLimit_NoPriority_impl(n);
 }
 
 template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::SetActiveThreadLimit_UsePriority_impl(
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::SetActiveThreadLimit_UsePriority_impl(
   size_t n
 ) {
   max_thread_space = std::max(n, max_thread_space);
   if (n > max_active_threads) {
     // Increasing total threads able to run simultaneously. This might increase
     // thread storage (threads).
-    for (size_t i = threads.size(); i < n; ++i) {
-      // add any new thread ids to unused threads.
+    // If requesting more possible active threads than space, resize (and add any new thread ids
+    // to unused threads).
+    const size_t old_size = threads.size();
+    if (n > old_size) ResizeThreadStorage(n);
+    for (size_t i = old_size; i < n; ++i) {
       unused_threads.emplace_back(i);
+      thread_membership.Set(i, membership_t::UNUSED);
     }
-    // If requesting more possible active threads than space, resize.
-    if (n > threads.size()) threads.resize(n);
   } else if (n < active_threads.size()) {
-    emp_assert(thread_exec_order.size() >= active_threads.size());
+    emp_assert(thread_exec_order.size() == active_threads.size());
     const size_t num_kill = active_threads.size() - n;
-    // Kill smallest-priority threads.
-    emp::vector<size_t> ids(active_threads.begin(), active_threads.end());
-    std::partial_sort(ids.begin(), ids.begin()+num_kill, ids.end(),
-                      [this](size_t id_a, size_t id_b){ return threads[id_a].GetPriority() < threads[id_b].GetPriority(); });
+    // Kill smallest-priority threads (each is removed from the execution order as it is killed).
     for (size_t i = 0; i < num_kill; ++i) {
-      const size_t thread_id = ids[i];
-      emp_assert(threads[thread_id].IsRunning());
+      const size_t thread_id = PeekMinActive();
       KillActiveThread_impl(thread_id);
     }
-    // Fix execution order in case we broke it.
-    emp::vector<size_t> new_thread_exec_order;
-    for (size_t thread_id : thread_exec_order) {
-      if (thread_id >= threads.size()) continue;
-      if (threads[thread_id].IsDead()) continue;
-      new_thread_exec_order.emplace_back(thread_id);
-    }
-    thread_exec_order = new_thread_exec_order;
   }
   max_active_threads = n;
 }
@@ -787,35 +1972,33 @@ template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::SetActiveThreadLimit_NoPriority_impl(
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::SetActiveThreadLimit_NoPriority_impl(
   size_t n
 ) {
   max_thread_space = std::max(n, max_thread_space);
   if (n > max_active_threads) {
     // Increasing total threads able to run simultaneously. This might increase
     // thread storage (threads).
-    for (size_t i = threads.size(); i < n; ++i) {
-      // add any new thread ids to unused threads.
+    // If requesting more possible active threads than space, resize (and add any new thread ids
+    // to unused threads).
+    const size_t old_size = threads.size();
+    if (n > old_size) ResizeThreadStorage(n);
+    for (size_t i = old_size; i < n; ++i) {
       unused_threads.emplace_back(i);
+      thread_membership.Set(i, membership_t::UNUSED);
     }
-    // If requesting more possible active threads than space, resize.
-    if (n > threads.size()) threads.resize(n);
   } else if (n < active_threads.size()) {
     // new thread limit is lower than current number of active threads.
-    emp_assert(thread_exec_order.size() >= active_threads.size());
-    // need to kill active threads to abide by new active thread limit.
+    emp_assert(thread_exec_order.size() == active_threads.size());
+    // need to kill active threads to abide by new active thread limit (most recently activated
+    // threads first).
     size_t num_kill = active_threads.size() - n;
     while (num_kill) {
-      const size_t thread_id = thread_exec_order.back();
-      if (threads[thread_id].IsRunning()) {
-        KillActiveThread_impl(thread_id);
-        --num_kill;
-      }
-      // Either thread was running and we killed it or thread was already dead.
-      // - either way, we needed to remove the thread from exec order.
-      thread_exec_order.pop_back();
+      KillActiveThread_impl(thread_exec_order.Back());
+      --num_kill;
     }
   }
   max_active_threads = n;
@@ -825,12 +2008,18 @@ template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::ResetBaseHardwareState()
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::ResetBaseHardwareState()
 {
   emp_assert(!is_executing, "Cannot reset hardware while executing.");
   ClearEventQueue();
+  event_wheel.Reset(); // Reset step count.
+  max_spawn_latency = 0;
+  num_instructions = 0;
+  is_halted = false;
+  cycle_detector.Reset();
   ResetThreads();
   is_executing = false;
 }
@@ -839,11 +2028,17 @@ template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::SetActiveThreadLimit(size_t n) {
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::SetActiveThreadLimit(size_t n) {
   emp_assert(n, "Max active thread limit must be > 0.", n);
   emp_assert(!is_executing, "Cannot adjust SignalGP hardware max thread count while executing.");
+  emp_assert(!step_in_progress, "Cannot adjust SignalGP hardware active thread limit while a step is paused.");
+  if constexpr (FIXED_CAPACITY) {
+    emp_assert(n == scheduler_t::MAX_ACTIVE_THREADS, "Active thread limit is fixed by the scheduler policy.", n);
+    return;
+  }
   // NOTE - this cannot DECREASE the capacity of the 'threads' member variable.
   //        It can, however, INCREASE the capacity of the 'threads' member variable.
   // Adjust max_thread_space if necessary.
@@ -854,12 +2049,18 @@ template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::SetThreadCapacity(size_t n)
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::SetThreadCapacity(size_t n)
 {
   emp_assert(n, "Max thread count must be greater than 0.");
   emp_assert(!is_executing, "Cannot adjust SignalGP hardware max thread count while executing.");
+  emp_assert(!step_in_progress, "Cannot adjust SignalGP hardware thread capacity while a step is paused.");
+  if constexpr (FIXED_CAPACITY) {
+    emp_assert(n == FIXED_THREAD_SPACE, "Thread capacity is fixed by the scheduler policy.", n);
+    return;
+  }
   // This function can both decrease AND increase the size of the threads vector.
   // If new thread cap < max active threads, decrease max active threads to new cap.
   if (n < max_active_threads) {
@@ -868,25 +2069,23 @@ void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::SetThreadCapac
   // If new thread cap < current thread storage, decrease thread storage, and update thread tracking.
   if (n < threads.size()) {
     // Lazily update
-    emp::vector<size_t> new_thread_exec_order;
-    emp::vector<size_t> new_unused_threads;
-    std::deque<size_t> new_pending_threads;
-    for (size_t id : thread_exec_order) {
-      if (id < n && !threads[id].IsDead()) new_thread_exec_order.emplace_back(id);
-    }
+    id_list_t new_unused_threads;
     for (size_t id : unused_threads) {
       if (id < n) new_unused_threads.emplace_back(id);
     }
-    for (size_t id : new_pending_threads) {
-      if (id < n) new_pending_threads.emplace_back(id);
+    // Filter pending threads in place (rotate each through the queue once).
+    for (size_t i = pending_threads.size(); i > 0; --i) {
+      const size_t id = pending_threads.Front();
+      pending_threads.PopFront();
+      if (id < n) pending_threads.PushBack(id);
     }
-    for (size_t id : active_threads) {
-      if (id >= n) active_threads.erase(n);
+    for (size_t i = woken_threads.size(); i > 0; --i) {
+      const size_t id = woken_threads.Front();
+      woken_threads.PopFront();
+      if (id < n) woken_threads.PushBack(id);
     }
-    thread_exec_order = new_thread_exec_order;
     unused_threads = new_unused_threads;
-    pending_threads = new_pending_threads;
-    threads.resize(n); // Decrease thread storage.
+    ResizeThreadStorage(n); // Decrease thread storage (drops active/exec order ids >= n).
   }
   max_thread_space = n;
 }
@@ -895,15 +2094,18 @@ template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::RemoveAllPendingThreads()
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::RemoveAllPendingThreads()
 {
   while (pending_threads.size()) {
-    const size_t thread_id = pending_threads.back();
-    pending_threads.pop_back();
-    threads[thread_id].Reset(); // this should be safe
+    const size_t thread_id = pending_threads.Back();
+    pending_threads.PopBack();
+    UnindexPendingPriority(thread_id);
+    threads.Reset(thread_id); // this should be safe
     unused_threads.emplace_back(thread_id);
+    thread_membership.Set(thread_id, membership_t::UNUSED);
   }
 }
 
@@ -911,21 +2113,64 @@ template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-emp::vector<size_t> BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::SpawnThreads(
+emp::vector<size_t> BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::SpawnThreads(
   const tag_t& tag,
   size_t n,
   double priority
 ) {
-  emp::vector<module_id_t> matches(GetHardware().FindModuleMatch(tag, n));
   emp::vector<size_t> thread_ids;
-  for (size_t match : matches) {
+  SpawnThreads(tag, n, priority, thread_ids);
+  return thread_ids;
+}
+
+template<
+  typename DERIVED_T,
+  typename EXEC_STATE_T,
+  typename TAG_T,
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
+>
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::SpawnThreads(
+  const tag_t& tag,
+  size_t n,
+  double priority,
+  emp::vector<size_t>& thread_ids
+) {
+  FindModuleMatches(tag, n, module_matches);
+  thread_ids.clear();
+  for (size_t match : module_matches) {
     const auto thread_id = SpawnThreadWithID(match, priority);
     if (thread_id) {
       thread_ids.emplace_back(thread_id.value());
     }
   }
+}
+
+template<
+  typename DERIVED_T,
+  typename EXEC_STATE_T,
+  typename TAG_T,
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
+>
+emp::vector<size_t> BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::SpawnThreads(
+  const tag_t& tag,
+  size_t n,
+  double priority,
+  emp::vector<spawn_result_t>& results
+) {
+  FindModuleMatches(tag, n, module_matches);
+  emp::vector<size_t> thread_ids;
+  results.clear();
+  for (size_t match : module_matches) {
+    results.emplace_back(SpawnThreadWithID(match, priority));
+    if (results.back()) {
+      thread_ids.emplace_back(results.back().value());
+    }
+  }
   return thread_ids;
 }
 
@@ -933,26 +2178,37 @@ template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-std::optional<size_t> BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::SpawnThreadWithTag(
+typename BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::spawn_result_t
+BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::SpawnThreadWithTag(
   const tag_t& tag,
   double priority
 ) {
-  emp::vector<module_id_t> match(GetHardware().FindModuleMatch(tag, 1));
-  return (match.size()) ? SpawnThreadWithID(match[0], priority) : std::nullopt;
+  const std::optional<module_id_t> match(FindBestModuleMatch(tag));
+  return (match) ? SpawnThreadWithID(*match, priority) : spawn_result_t(spawn_status_t::REJECTED_NO_MATCH);
 }
 
 template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-std::optional<size_t> BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::SpawnThreadWithID(
+typename BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::spawn_result_t
+BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::SpawnThreadWithID(
   module_id_t module_id,
   double priority
 ) {
+  OnExternalChange();
+  // Admission control: don't spend a thread slot on a thread that cannot possibly run.
+  if (use_spawn_admission_control && !IsSpawnAdmissible(priority)) {
+    return spawn_result_t(
+      IsThreadPriorityUsed() ? spawn_status_t::REJECTED_PRIORITY : spawn_status_t::REJECTED_NO_SPACE
+    );
+  }
   size_t thread_id;
   bool already_pending = false; // Flag if claimed thread id is already pending.
   // Is there an unused thread to commandeer?
@@ -960,142 +2216,353 @@ std::optional<size_t> BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T
     // Unused thread is available, use it.
     thread_id = unused_threads.back();
     unused_threads.pop_back();
+    emp_assert(thread_membership.Check(thread_id, membership_t::UNUSED), "Thread ID not tracked as unused", thread_id);
   } else if (threads.size() < max_thread_space) {
     // No unused threads available, but we have space to make a new one.
     thread_id = threads.size();
-    threads.emplace_back();
-  } else if (use_thread_priority && pending_threads.size()) {
-    // Is there a pending thread w/lower priority?
-    size_t min_priority_pending_id = pending_threads.front();
-    for (size_t pending_id : pending_threads) {
-      if (threads[pending_id].GetPriority() < threads[min_priority_pending_id].GetPriority()) {
-        min_priority_pending_id = pending_id;
-      }
-    }
-    // If so, use it. Otherwise, return nullopt.
-    if (priority > threads[min_priority_pending_id].GetPriority()) {
+    ResizeThreadStorage(thread_id + 1);
+  } else if (SCHED_INDEXES_PRIORITY && IsThreadPriorityUsed() && pending_threads.size()) {
+    // Is there a pending thread w/lower priority? (ties broken by lowest thread id, or by latest
+    // arrival in priority-bucket mode)
+    const size_t min_priority_pending_id = PeekMinPending();
+    // If so, use it. Otherwise, reject.
+    if (GetSchedPriority(priority) > GetThreadSchedPriority(min_priority_pending_id)) {
+      emp_assert(thread_membership.Check(min_priority_pending_id, membership_t::PENDING));
       thread_id = min_priority_pending_id;
       already_pending = true;
     } else {
-      return std::nullopt;
+      return spawn_result_t(spawn_status_t::REJECTED_NO_SPACE);
     }
   } else {
     // No unused threads available && !use_thread_priority && no more thread space
-    return std::nullopt;
+    return spawn_result_t(spawn_status_t::REJECTED_NO_SPACE);
   }
   // If we make it here, we have a valid thread_id to use.
   emp_assert(thread_id < threads.size());
 
-  // We've identified a thread to commandeer. Reset it, initialize it, and
-  // mark it appropriately.
-  thread_t & thread = threads[thread_id];
-  thread.Reset();
-  thread.SetPriority(priority);
+  // We've identified a thread to commandeer. Reset it and mark it appropriately.
+  threads.Reset(thread_id);
+  threads.SetPriority(thread_id, priority);
+  threads.SetSpawnStep(thread_id, GetNumSteps());
 
-  // Let derived hardware initialize thread w/appropriate module.
-  GetHardware().InitThread(thread, module_id);
+  // Defer initialization (DERIVED_T::InitThread) until the thread is activated; many pending
+  // threads are never activated.
+  threads.DeferInit(thread_id, module_id);
 
   // Mark thread as pending.
-  thread.SetPending();
-  if (!already_pending) pending_threads.emplace_back(thread_id);
+  threads.SetRunState(thread_id, thread_state_t::PENDING);
+  if (is_executing) ++thread_change_cnt;
+  if (!already_pending) {
+    pending_threads.PushBack(thread_id);
+    IndexPendingPriority(thread_id);
+    thread_membership.Set(thread_id, membership_t::PENDING);
+  } else {
+    // Re-index the commandeered pending thread as a new arrival.
+    UnindexPendingPriority(thread_id);
+    IndexPendingPriority(thread_id);
+  }
 
-  return std::optional<size_t>{thread_id}; // this could mess with thread priority level!
+  return spawn_result_t(
+    already_pending ? spawn_status_t::REPLACED_PENDING : spawn_status_t::SPAWNED,
+    thread_id
+  );
 }
 
 template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::SingleProcess()
-{
-  // Handle events (which may spawn threads)
-  while (!event_queue.empty()) {
-    HandleEvent(*(event_queue.front()));
-    event_queue.pop_front();
-  }
+template<typename PAUSE_FUN_T>
+bool BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::SingleProcess_impl(
+  PAUSE_FUN_T& should_pause
+) {
+  emp_assert(!is_executing, "Cannot start a step while executing.");
+  size_t thread_id = resume_thread_id;
+  if (step_in_progress) {
+    // Resume the paused step.
+    step_in_progress = false;
+    resume_thread_id = sched::RunList::npos;
+  } else {
+    // Advance the step count, queuing any events scheduled for this step.
+    event_wheel.Advance([this](std::shared_ptr<event_t>&& event) {
+      event_queue.PushBack(std::move(event));
+    });
+
+    // Handle events (which may spawn threads)
+    while (!event_queue.empty()) {
+      const std::shared_ptr<event_t> event(std::move(event_queue.Front()));
+      event_queue.PopFront();
+      HandleEvent(*event);
+    }
+
+    // Resume woken threads and activate pending threads. (which may kill currently active threads)
+    if (!pending_threads.empty() || !woken_threads.empty()) ActivatePendingThreads();
+    emp_assert(active_threads.size() <= max_active_threads);
 
-  // Activate all pending threads. (which may kill currently active threads)
-  ActivatePendingThreads();
-  emp_assert(active_threads.size() <= max_active_threads);
+    // Fast path: nothing to execute.
+    if (thread_exec_order.empty()) return true;
+
+    if (IsParallelExecutionUsed()) {
+      ExecuteThreads_Parallel_impl();
+      return true;
+    }
+    thread_id = thread_exec_order.Front();
+  }
 
   // Begin execution!
+  // NOTE: while executing, threads are only ever removed from the execution order by this loop
+  //       (threads that die or block are marked, then removed here), and threads activated during
+  //       execution do not run until the next SingleProcess.
   is_executing = true;
   cur_thread.Validate();    // cur_thread is valid during execution.
-  size_t exec_order_id = 0;
-  size_t thread_exec_cnt = thread_exec_order.size();
-  size_t adjust = 0;
-  while (exec_order_id < thread_exec_cnt) {
-    emp_assert(exec_order_id < thread_exec_order.size()); // Exec order ID should always be valid thread.
-    cur_thread.id = thread_exec_order[exec_order_id];
-
-    // Do we need to move the current thread id over in the execution ordering
-    // to make our execution order contiguous?
-    if (adjust) {
-      // If we need to adjust, invalidate current position and move current
-      // thread id up by 'adjust'.
-      thread_exec_order[exec_order_id] = max_thread_space; // Invalid position!
-      thread_exec_order[exec_order_id - adjust] = cur_thread.ID();
-    }
+  while (thread_id != sched::RunList::npos) {
+    cur_thread.id = thread_id;
+    const size_t next_id = thread_exec_order.Next(thread_id);
 
-    // Is this a valid thread id?
-    if (cur_thread.id >= threads.size()) {
-      // If this thread is active, kill it.
-      if (emp::Has(active_threads, cur_thread.ID())) KillActiveThread_impl(cur_thread.ID());
-      ++adjust;
-      ++exec_order_id;
+    // Is this thread dead?
+    if (threads.GetRunState(thread_id) == thread_state_t::DEAD) {
+      KillActiveThread_impl(thread_id);
+      thread_id = next_id;
       continue;
     }
-    // Is this thread dead?
-    if (threads[cur_thread.ID()].IsDead()) {
-      // If this thread is active, kill it.
-      if (emp::Has(active_threads, cur_thread.ID())) KillActiveThread_impl(cur_thread.ID());
-      ++adjust;
-      ++exec_order_id;
+    // Was this thread blocked (by another thread or while the hardware was not executing)?
+    if (threads.GetRunState(thread_id) == thread_state_t::BLOCKED) {
+      ParkBlockedThread(thread_id);
+      thread_id = next_id;
       continue;
     }
 
-    // Execute the thread (defined by derived class)
-    GetHardware().SingleExecutionStep(GetHardware(), threads[cur_thread.ID()]);
+    // Execute the thread (defined by derived class) for up to quantum steps.
+    thread_t thread(threads[thread_id]);
+    const size_t quantum = IsFairShareSchedulingUsed() ? GetFairShareQuantum(thread_id) : GetThreadQuantum();
+    if (quantum && !threads.GetNumExecSteps(thread_id)) RecordFirstExecStep(thread_id);
+    const size_t change_cnt = thread_change_cnt;
+    size_t num_steps = 0;
+    while (num_steps < quantum) {
+      GetHardware().SingleExecutionStep(GetHardware(), thread);
+      ++num_steps;
+      if (threads.GetRunState(thread_id) != thread_state_t::RUNNING) break;
+      if (yield_on_thread_change && change_cnt != thread_change_cnt) break;
+    }
+    threads.AddExecSteps(thread_id, num_steps);
+    num_instructions += num_steps;
+    if (IsFairShareSchedulingUsed()) ChargeFairShare(thread_id, num_steps);
 
     // Did the thread die?
-    if (threads[cur_thread.ID()].IsDead()) {
-      KillActiveThread_impl(cur_thread.ID());
-      ++adjust;
+    const thread_state_t run_state = threads.GetRunState(thread_id);
+    if (run_state == thread_state_t::DEAD) {
+      KillActiveThread_impl(thread_id);
+    } else if (run_state == thread_state_t::BLOCKED) {
+      // Did the thread block? Park it until it is woken.
+      ParkBlockedThread(thread_id);
+    }
+    thread_id = next_id;
+
+    // Pause (before the next thread's turn)?
+    if (thread_id != sched::RunList::npos && should_pause()) {
+      step_in_progress = true;
+      resume_thread_id = thread_id;
+      break;
     }
-    ++exec_order_id;
   }
   is_executing = false;
-
-  // Update the thread execution ordering to be accurate.
-  thread_exec_order.resize(thread_exec_cnt - adjust);
-  emp_assert(thread_exec_order.size() == active_threads.size()); // discussion - right?
+  emp_assert(thread_exec_order.size() == active_threads.size());
 
   // Invalidate the current thread id.
   cur_thread.id = max_thread_space;
   cur_thread.Invalidate();
+  return !step_in_progress;
 }
 
 template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::PrintThreadUsage(
+typename BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::process_result_t
+BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::ProcessFor(
+  const process_budget_t& budget
+) {
+  using wall_clock_t = typename process_budget_t::wall_clock_t;
+  emp_assert(!is_executing, "Cannot process hardware while executing.");
+  const auto start_time = wall_clock_t::now();
+  const size_t start_instructions = num_instructions;
+  const size_t max_instructions = budget.max_instructions;
+  process_result_t result;
+  // The clock is read once every clock_check_interval instructions (or steps).
+  size_t next_clock_check = budget.clock_check_interval;
+  auto work_done = [this, &result, start_instructions]() {
+    return (num_instructions - start_instructions) + result.num_steps;
+  };
+  auto out_of_budget = [&]() {
+    if (num_instructions - start_instructions >= max_instructions) {
+      result.reason = sched::ProcessStopReason::INSTRUCTIONS;
+      return true;
+    }
+    if (budget.deadline && work_done() >= next_clock_check) {
+      next_clock_check = work_done() + budget.clock_check_interval;
+      if (wall_clock_t::now() >= *budget.deadline) {
+        result.reason = sched::ProcessStopReason::DEADLINE;
+        return true;
+      }
+    }
+    return false;
+  };
+
+  if (budget.deadline && start_time >= *budget.deadline) {
+    result.reason = sched::ProcessStopReason::DEADLINE;
+  } else {
+    while (true) {
+      if (result.num_steps >= budget.max_steps) {
+        result.reason = sched::ProcessStopReason::STEPS;
+        break;
+      }
+      if (out_of_budget()) break;
+      if (is_halted) {
+        result.reason = sched::ProcessStopReason::HALTED;
+        break;
+      }
+      if (!step_in_progress && IsIdle()) {
+        result.reason = sched::ProcessStopReason::IDLE;
+        break;
+      }
+      if (!SingleProcess_impl(out_of_budget)) break;
+      ++result.num_steps;
+      if (use_cycle_detection) CheckForCycle();
+    }
+  }
+  result.num_instructions = num_instructions - start_instructions;
+  result.step_in_progress = step_in_progress;
+  result.elapsed = wall_clock_t::now() - start_time;
+  return result;
+}
+
+template<
+  typename DERIVED_T,
+  typename EXEC_STATE_T,
+  typename TAG_T,
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
+>
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::ExecuteThreads_Parallel_impl()
+{
+  if constexpr (decltype(DetectIsThreadLocalStep<DERIVED_T>(0))::value) {
+    is_executing = true;
+    cur_thread.Validate();
+    // (1) Pick the threads that execute ahead: running threads whose next step is thread-local.
+    //     Their turns cannot be affected by the threads before them in the execution order (which
+    //     may not kill or block them), so their quanta can be decided now.
+    ahead_quanta.resize(threads.size(), NOT_AHEAD);
+    ahead_steps.resize(threads.size(), 0);
+    parallel_batch.clear();
+    for (size_t id = thread_exec_order.Front(); id != sched::RunList::npos; id = thread_exec_order.Next(id)) {
+      if (threads.GetRunState(id) != thread_state_t::RUNNING) continue;
+      thread_t thread(threads[id]);
+      if (!GetHardware().IsThreadLocalStep(thread)) continue;
+      const size_t quantum = IsFairShareSchedulingUsed() ? GetFairShareQuantum(id) : GetThreadQuantum();
+      if (quantum && !threads.GetNumExecSteps(id)) RecordFirstExecStep(id);
+      ahead_quanta[id] = quantum;
+      if (quantum) parallel_batch.emplace_back(id);
+    }
+
+    // (2) Execute those threads ahead, in parallel, until they run out of quantum, stop running,
+    //     or reach a step that is not thread-local.
+    auto execute_ahead = [this](size_t i) {
+      const size_t id = parallel_batch[i];
+      parallel_cur_thread = id;
+      thread_t thread(threads[id]);
+      const size_t quantum = ahead_quanta[id];
+      size_t num_steps = 0;
+      do {
+        GetHardware().SingleExecutionStep(GetHardware(), thread);
+        ++num_steps;
+      } while (
+        num_steps < quantum
+        && threads.GetRunState(id) == thread_state_t::RUNNING
+        && GetHardware().IsThreadLocalStep(thread)
+      );
+      ahead_steps[id] = num_steps;
+    };
+    in_parallel_phase = true;
+    worker_pool->Run(parallel_batch.size(), execute_ahead);
+    in_parallel_phase = false;
+
+    // (3) Finish each thread's turn, in execution order (as in SingleProcess).
+    size_t thread_id = thread_exec_order.Front();
+    while (thread_id != sched::RunList::npos) {
+      cur_thread.id = thread_id;
+      const size_t next_id = thread_exec_order.Next(thread_id);
+      size_t quantum = ahead_quanta[thread_id];
+      size_t num_steps = 0;
+      if (quantum == NOT_AHEAD) {
+        if (threads.GetRunState(thread_id) == thread_state_t::DEAD) {
+          KillActiveThread_impl(thread_id);
+          thread_id = next_id;
+          continue;
+        }
+        if (threads.GetRunState(thread_id) == thread_state_t::BLOCKED) {
+          ParkBlockedThread(thread_id);
+          thread_id = next_id;
+          continue;
+        }
+        quantum = IsFairShareSchedulingUsed() ? GetFairShareQuantum(thread_id) : GetThreadQuantum();
+        if (quantum && !threads.GetNumExecSteps(thread_id)) RecordFirstExecStep(thread_id);
+      } else {
+        ahead_quanta[thread_id] = NOT_AHEAD;
+        num_steps = ahead_steps[thread_id];
+        ahead_steps[thread_id] = 0;
+      }
+
+      thread_t thread(threads[thread_id]);
+      const size_t change_cnt = thread_change_cnt;
+      if (!num_steps || threads.GetRunState(thread_id) == thread_state_t::RUNNING) {
+        while (num_steps < quantum) {
+          GetHardware().SingleExecutionStep(GetHardware(), thread);
+          ++num_steps;
+          if (threads.GetRunState(thread_id) != thread_state_t::RUNNING) break;
+          if (yield_on_thread_change && change_cnt != thread_change_cnt) break;
+        }
+      }
+      threads.AddExecSteps(thread_id, num_steps);
+      num_instructions += num_steps;
+      if (IsFairShareSchedulingUsed()) ChargeFairShare(thread_id, num_steps);
+
+      const thread_state_t run_state = threads.GetRunState(thread_id);
+      if (run_state == thread_state_t::DEAD) {
+        KillActiveThread_impl(thread_id);
+      } else if (run_state == thread_state_t::BLOCKED) {
+        ParkBlockedThread(thread_id);
+      }
+      thread_id = next_id;
+    }
+    is_executing = false;
+    emp_assert(thread_exec_order.size() == active_threads.size());
+
+    cur_thread.id = max_thread_space;
+    cur_thread.Invalidate();
+  }
+}
+
+template<
+  typename DERIVED_T,
+  typename EXEC_STATE_T,
+  typename TAG_T,
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
+>
+void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::PrintThreadUsage(
   std::ostream& os
 ) const {
   // All threads (and state)
   os << "All allocated (" << threads.size() << "); [";
   for (size_t i = 0; i < threads.size(); ++i) {
     if (i) os << ", ";
-    char state;
-    if (threads[i].IsDead()) state = 'D';
-    else if (threads[i].IsRunning()) state = 'A';
-    else if (threads[i].IsPending()) state = 'P';
-    else state = '?';
-    os << i << " (" << state << ":" << threads[i].GetPriority() << ")";
+    os << i << " (" << GetThreadStateChar(threads.GetRunState(i)) << ":" << threads.GetPriority(i) << ")";
   }
   os << "]\n";
   // Active threads
@@ -1121,17 +2588,30 @@ void BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::PrintThreadUsa
     os << pending_threads[i];
   }
   os << "]\n";
+  // Woken threads
+  os << "Woken threads (" << woken_threads.size() << "): [";
+  for (size_t i = 0; i < woken_threads.size(); ++i) {
+    if (i) os << ", ";
+    os << woken_threads[i];
+  }
+  os << "]\n";
+  // Blocked threads
+  os << "Blocked threads (" << blocked_threads.size() << "): [";
+  comma = false;
+  for (size_t i = 0; i < threads.size(); ++i) {
+    if (!blocked_threads.Has(i)) continue;
+    if (comma) os << ", ";
+    else comma = true;
+    os << i << " (key:" << blocked_threads.GetKey(i) << ")";
+  }
+  os << "]\n";
   // Execution order
   os << "Execution order (" << thread_exec_order.size() << "): [";
-  for (size_t i = 0; i < thread_exec_order.size(); ++i) {
-    if (i) os << ", ";
-    size_t thread_id = thread_exec_order[i];
-    char state;
-    if (threads[thread_id].IsDead()) state = 'D';
-    else if (threads[thread_id].IsRunning()) state = 'A';
-    else if (threads[thread_id].IsPending()) state = 'P';
-    else state = '?';
-    os << thread_id << " (" << state << ")";
+  comma = false;
+  for (size_t thread_id : thread_exec_order) {
+    if (comma) os << ", ";
+    else comma = true;
+    os << thread_id << " (" << GetThreadStateChar(threads.GetRunState(thread_id)) << ")";
   }
   os << "]";
 }
@@ -1140,44 +2620,93 @@ template<
   typename DERIVED_T,
   typename EXEC_STATE_T,
   typename TAG_T,
-  typename CUSTOM_COMPONENT_T
+  typename CUSTOM_COMPONENT_T,
+  typename SCHEDULER_T
 >
-bool BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T>::ValidateThreadState() {
+bool BaseCPU<DERIVED_T, EXEC_STATE_T, TAG_T, CUSTOM_COMPONENT_T, SCHEDULER_T>::ValidateThreadState() {
   emp_assert(!is_executing);
   // (1) Thread storage should not exceed max_thread_capacity
   if (threads.size() > max_thread_space) return false;
   // (2) # of active threads should not exceed max_active_threads
   if (active_threads.size() > max_active_threads) return false;
-  // (3) No thread ID should appear more than once in the execution order.
-  std::unordered_set<size_t> exec_order_set(thread_exec_order.begin(), thread_exec_order.end());
-  if (exec_order_set.size() != thread_exec_order.size()) return false;
-  // (4) No thread ID should appear more than once in the unused threads tracker.
-  std::unordered_set<size_t> unused_set(unused_threads.begin(), unused_threads.end());
-  if (unused_set.size() != unused_threads.size()) return false;
-  // (5) No thread ID should appear more than once in the pending threads tracker.
-  std::unordered_set<size_t> pending_set(pending_threads.begin(), pending_threads.end());
-  if (pending_set.size() != pending_threads.size()) return false;
-  // (6) No thread ID should appear more than once across ACTIVE, UNUSED, & PENDING threads.
+  // (3) The execution order should contain exactly the active threads.
+  if (thread_exec_order.size() != active_threads.size()) return false;
+  for (size_t id : active_threads) {
+    if (!thread_exec_order.Has(id)) return false;
+  }
+  // (4) No thread ID should appear more than once across ACTIVE, UNUSED, PENDING, WOKEN, & (parked)
+  //     BLOCKED threads (so, also not more than once within the unused, pending, or woken threads
+  //     trackers).
   //     - Also, all thread IDs should be valid (id < threads.size())!
+  //     - (debug builds) Each thread's tracked membership should match where it appears.
   emp::vector<size_t> id_appearances(threads.size(), 0);
   for (size_t id : active_threads) {
     if (id >= threads.size()) return false;
+    if (!thread_membership.Check(id, membership_t::ACTIVE)) return false;
     id_appearances[id] += 1;
   }
   for (size_t id : unused_threads) {
     if (id >= threads.size()) return false;
+    if (!thread_membership.Check(id, membership_t::UNUSED)) return false;
     id_appearances[id] += 1;
   }
   for (size_t id : pending_threads) {
     if (id >= threads.size()) return false;
+    if (!thread_membership.Check(id, membership_t::PENDING)) return false;
+    id_appearances[id] += 1;
+  }
+  for (size_t id : woken_threads) {
+    if (id >= threads.size()) return false;
+    if (!thread_membership.Check(id, membership_t::WOKEN)) return false;
+    if (threads.GetRunState(id) != thread_state_t::PENDING) return false;
     id_appearances[id] += 1;
   }
   for (size_t id = 0; id < id_appearances.size(); ++id) {
+    if (blocked_threads.Has(id) && !active_threads.Has(id)) {
+      if (!thread_membership.Check(id, membership_t::PARKED)) return false;
+      id_appearances[id] += 1;
+    }
     if (id_appearances[id] != 1) return false;
+    // Threads should be blocked if and only if they have a wait key.
+    if ((threads.GetRunState(id) == thread_state_t::BLOCKED) != blocked_threads.Has(id)) return false;
+  }
+  // (5) Every thread in active threads should NOT be marked as pending (either dead or active OKAY)
+  for (size_t id : active_threads) {
+    if (threads.GetRunState(id) == thread_state_t::PENDING) return false;
+    if (threads.IsInitDeferred(id)) return false;
+  }
+  // (6) Priority index should track exactly the active/pending threads at their current priorities
+  //     (or be empty, if the scheduler policy does not index threads by priority).
+  if constexpr (!SCHED_INDEXES_PRIORITY) {
+    return !(pending_priorities_MAX.size() || pending_priorities_MIN.size() || active_priorities_MIN.size()
+      || pending_buckets.size() || active_buckets.size());
+  }
+  if (IsPriorityBucketMode()) {
+    if (pending_priorities_MAX.size() || pending_priorities_MIN.size() || active_priorities_MIN.size()) return false;
+    if (active_buckets.size() != active_threads.size()) return false;
+    if (pending_buckets.size() != pending_threads.size()) return false;
+    for (size_t id : active_threads) {
+      if (!active_buckets.Has(id)) return false;
+      if (active_buckets.GetLevel(id) != GetPriorityLevel(threads.GetPriority(id))) return false;
+    }
+    for (size_t id : pending_threads) {
+      if (!pending_buckets.Has(id)) return false;
+      if (pending_buckets.GetLevel(id) != GetPriorityLevel(threads.GetPriority(id))) return false;
+    }
+    return true;
   }
-  // (7) Every thread in active threads should NOT be marked as pending (either dead or active OKAY)
+  if (active_buckets.size() || pending_buckets.size()) return false;
+  if (active_priorities_MIN.size() != active_threads.size()) return false;
+  if (pending_priorities_MAX.size() != pending_threads.size()) return false;
+  if (pending_priorities_MIN.size() != pending_threads.size()) return false;
   for (size_t id : active_threads) {
-    if (threads[id].IsPending()) return false;
+    if (!active_priorities_MIN.Has(id)) return false;
+    if (active_priorities_MIN.GetKey(id) != GetPriorityKey(id)) return false;
+  }
+  for (size_t id : pending_threads) {
+    if (!pending_priorities_MAX.Has(id) || !pending_priorities_MIN.Has(id)) return false;
+    if (pending_priorities_MAX.GetKey(id) != GetPriorityKey(id)) return false;
+    if (pending_priorities_MIN.GetKey(id) != GetPriorityKey(id)) return false;
   }
   // If all of that passed, return true (i.e., thread management is valid).
   return true;
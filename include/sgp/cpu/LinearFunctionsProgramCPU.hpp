@@ -3,6 +3,7 @@
 #include <iostream>
 #include <utility>
 #include <memory>
+#include <optional>
 
 #include "emp/base/Ptr.hpp"
 #include "emp/base/vector.hpp"
@@ -12,6 +13,7 @@
 
 #include "../EventLibrary.hpp"
 #include "../inst/InstructionLibrary.hpp"
+#include "../utils/hash_utils.hpp"
 
 #include "BaseCPU.hpp"
 
@@ -34,19 +36,22 @@ template<
     emp::RankedSelector<>,
     emp::AdditiveCountdownRegulator<>
   >,
-  typename CUSTOM_COMPONENT_T=sgp::cpu::DefaultCustomComponent
+  typename CUSTOM_COMPONENT_T=sgp::cpu::DefaultCustomComponent,
+  typename SCHEDULER_T=sched::ConfigurableScheduler
 >
-class LinearFunctionsProgramCPU : public BaseCPU<
+class LinearFunctionsProgramCPU final : public BaseCPU<
   LinearFunctionsProgramCPU<
     MEMORY_MODEL_T,
     // TAG_T,
     INST_ARGUMENT_T,
     MATCHBIN_T,
-    CUSTOM_COMPONENT_T
+    CUSTOM_COMPONENT_T,
+    SCHEDULER_T
   >,
   linprg::ExecState<MEMORY_MODEL_T>,
   typename MATCHBIN_T::tag_t,
-  CUSTOM_COMPONENT_T
+  CUSTOM_COMPONENT_T,
+  SCHEDULER_T
 > {
 public:
   // Type aliases
@@ -55,7 +60,8 @@ public:
     // TAG_T,
     INST_ARGUMENT_T,
     MATCHBIN_T,
-    CUSTOM_COMPONENT_T
+    CUSTOM_COMPONENT_T,
+    SCHEDULER_T
   >;
   // -- Control flow --
   using exec_state_t = linprg::ExecState<MEMORY_MODEL_T>;
@@ -67,6 +73,8 @@ public:
   using fun_open_flow_t = typename flow_handler_t::fun_open_flow_t;
   // -- Program --
   using matchbin_t = MATCHBIN_T;
+  /// Regulator type of the matchbin (regulates how strongly each function matches).
+  using regulator_t = std::decay_t<decltype(std::declval<matchbin_t&>().GetRegulator(0))>;
   using tag_t = typename matchbin_t::tag_t;
   using arg_t = INST_ARGUMENT_T;
   using program_t = lfunprg::LinearFunctionsProgram<tag_t, arg_t>;
@@ -74,7 +82,7 @@ public:
   using memory_model_t = MEMORY_MODEL_T;
   using memory_state_t = typename memory_model_t::memory_state_t;
   // -- Virtual hardware --
-  using base_hw_t = BaseCPU<this_t, exec_state_t, tag_t, CUSTOM_COMPONENT_T>;
+  using base_hw_t = BaseCPU<this_t, exec_state_t, tag_t, CUSTOM_COMPONENT_T, SCHEDULER_T>;
   using thread_t = typename base_hw_t::Thread;
   using event_lib_t = typename base_hw_t::event_lib_t; // EventLibrary<this_t>
   using event_t = typename base_hw_t::event_t;
@@ -84,7 +92,18 @@ public:
   using inst_lib_t = inst::InstructionLibrary<this_t, inst_t>;
   using inst_prop_t = inst::InstProperty;
 
+  /// Saved hardware state (see BaseCPU::Snapshot): BaseCPU's state (threads, events, etc.), plus
+  /// the memory model (e.g., global memory) and the matchbin's function regulators.
+  struct SavedState : base_hw_t::BaseState {
+    memory_model_t memory_model;
+    emp::vector<regulator_t> regulators; ///< Regulator of each function (including, e.g., its timer).
+    size_t program_version=0;        ///< Program (see ResetMatchBin) that the state was saved with.
+  };
+  using snapshot_t = SavedState;
+
 protected:
+  friend base_hw_t; ///< BaseCPU calls ResetImpl.
+
   inst_lib_t& inst_lib;
   flow_handler_t flow_handler;
   memory_model_t memory_model;
@@ -97,6 +116,7 @@ protected:
   }; // todo - can we do a better job baking this in?
 
   size_t max_call_depth;
+  size_t program_version=0; ///< Incremented whenever the matchbin is rebuilt for a program (see RestoreState).
 
   void SetupDefaultFlowControl_Basic() {
     // ON OPEN
@@ -333,6 +353,7 @@ public:
   void ResetMatchBin() {
     matchbin.Clear();
     is_matchbin_cache_dirty = false;
+    ++program_version;
     for (size_t i = 0; i < program.GetSize(); ++i) {
       matchbin.Set(i, program[i].GetTag(), i);
     }
@@ -363,6 +384,61 @@ public:
   matchbin_t& GetMatchBin() { return matchbin; }
   const matchbin_t& GetMatchBin() const { return matchbin; }
 
+  /// Get the matchbin regulator of the given function. (emp::MatchBin::GetRegulator is not const, but
+  /// it does not modify the matchbin.)
+  const regulator_t& GetRegulator(size_t uid) const {
+    return const_cast<matchbin_t&>(matchbin).GetRegulator(uid);
+  }
+
+  /// Save LinearFunctionsProgramCPU's part of a snapshot (see BaseCPU::Snapshot).
+  void SaveState(snapshot_t& snapshot) const {
+    snapshot.memory_model = memory_model;
+    snapshot.regulators.resize(program.GetSize());
+    for (size_t i = 0; i < program.GetSize(); ++i) snapshot.regulators[i] = GetRegulator(i);
+    snapshot.program_version = program_version;
+  }
+
+  /// Restore LinearFunctionsProgramCPU's part of a snapshot (see BaseCPU::Restore). The program must
+  /// not have changed since the snapshot was taken.
+  void RestoreState(const snapshot_t& snapshot) {
+    emp_assert(snapshot.program_version == program_version, "Program changed since snapshot was taken.");
+    emp_assert(snapshot.regulators.size() == program.GetSize());
+    memory_model = snapshot.memory_model;
+    for (size_t i = 0; i < program.GetSize(); ++i) matchbin.SetRegulator(i, snapshot.regulators[i]);
+  }
+
+  /// Hash hardware-wide state that affects execution (see BaseCPU::SetCycleDetection): the memory
+  /// model's state (e.g., global memory) and function regulators. (Only available if the memory
+  /// model can hash its state.)
+  template<typename MEM_MODEL_T=memory_model_t>
+  auto HashState() const -> decltype(std::declval<const MEM_MODEL_T&>().HashState(), size_t()) {
+    size_t hash = memory_model.HashState();
+    for (size_t i = 0; i < program.GetSize(); ++i) hash = utils::HashRegulator(hash, GetRegulator(i));
+    return hash;
+  }
+
+  /// Hash an execution state (see BaseCPU::SetCycleDetection): each call's memory and flow stack.
+  template<typename MEM_MODEL_T=memory_model_t>
+  auto HashExecState(const exec_state_t& state) const -> decltype(
+    std::declval<const MEM_MODEL_T&>().HashMemoryState(std::declval<const memory_state_t&>()),
+    size_t()
+  ) {
+    size_t hash = state.call_stack.size();
+    for (const call_state_t& call_state : state.call_stack) {
+      hash = utils::HashCombine(hash, call_state.circular);
+      hash = utils::HashCombine(hash, memory_model.HashMemoryState(call_state.memory));
+      hash = utils::HashCombine(hash, call_state.flow_stack.size());
+      for (const flow_info_t& flow : call_state.flow_stack) {
+        hash = utils::HashCombine(hash, flow.type);
+        hash = utils::HashCombine(hash, flow.mp);
+        hash = utils::HashCombine(hash, flow.ip);
+        hash = utils::HashCombine(hash, flow.begin);
+        hash = utils::HashCombine(hash, flow.end);
+      }
+    }
+    return hash;
+  }
+
   /// Set program for this hardware object.
   void SetProgram(const program_t& p) {
     this->Reset();   // Full hardware reset
@@ -428,9 +504,37 @@ public:
   void InitThread(thread_t& thread, size_t module_id) {
     emp_assert(module_id < program.GetSize(), "Invalid module_id.", module_id);
     exec_state_t& state = thread.GetExecState();
-    if (state.call_stack.size()) { state.Clear(); } // reset the thread's call stack.
+    // Reset the thread's call stack.
+    if (state.call_stack.size()) {
+      if (this->IsExecStateRecyclingUsed()) state.RecycleCallStack();
+      else state.Clear();
+    }
     emp_assert(state.call_stack.size() == 0);
     CallModule(module_id, state);
+    // If memory was staged for this thread before it was initialized (e.g., by Fork), it becomes
+    // the memory of the thread's first call state.
+    if (state.init_memory) {
+      if (state.call_stack.size()) state.GetTopCallState().memory = std::move(*state.init_memory);
+      state.init_memory.reset();
+    }
+  }
+
+  /// Apply the memory model's module-call semantics (OnModuleCall) from caller_mem to the given
+  /// spawned thread, as though caller_mem's owner called the spawned thread's module.
+  /// Spawned threads are initialized lazily (when activated); if the thread has not been
+  /// initialized yet, the call is applied to staged memory that InitThread will hand to the
+  /// thread's first call state.
+  void HandoffSpawnMemory(size_t thread_id, memory_state_t& caller_mem) {
+    emp_assert(thread_id < this->threads.size(), "Invalid thread id.", thread_id);
+    // NOTE: access thread storage directly; GetThread would initialize the thread.
+    thread_t thread(this->threads[thread_id]);
+    exec_state_t& state = thread.GetExecState();
+    if (thread.IsInitDeferred()) {
+      if (!state.init_memory) state.init_memory.emplace(memory_model.CreateMemoryState());
+      memory_model.OnModuleCall(caller_mem, *state.init_memory);
+    } else if (state.call_stack.size()) {
+      memory_model.OnModuleCall(caller_mem, state.GetTopCallState().GetMemory());
+    }
   }
 
   // InstPropertyBLOCK_CLOSEBLOCK_DEF
@@ -468,9 +572,9 @@ public:
     // Are we at max depth already?
     if (exec_state.call_stack.size() >= max_call_depth) return;
     // Find the best matching module!
-    emp::vector<size_t> matches(FindModuleMatch(tag));
-    if (matches.size()) {
-      CallModule(matches[0], exec_state, circular);
+    const std::optional<size_t> match(this->FindBestModuleMatch(tag));
+    if (match) {
+      CallModule(*match, exec_state, circular);
     }
   }
 
@@ -483,8 +587,12 @@ public:
     // Are we at max depth already?
     if (exec_state.call_stack.size() >= max_call_depth) return;
     if (program[module_id].GetSize() < 1) return;
-    // Push new state to call stack.
-    exec_state.call_stack.emplace_back(memory_model.CreateMemoryState(), circular);
+    // Push new state onto stack (reusing a recycled call state if there is one).
+    if (exec_state.HasSpareCallState()) {
+      exec_state.ReuseCallState(circular);
+    } else {
+      exec_state.call_stack.emplace_back(memory_model.CreateMemoryState(), circular);
+    }
     // note - flow info is different?
     // todo - double check that this FlowInfo is fine
     flow_handler.OpenFlow(*this, {flow_t::CALL, module_id, 0, 0, program[module_id].GetSize()}, exec_state);
@@ -509,7 +617,8 @@ public:
       memory_model.OnModuleReturn(returning_state.GetMemory(), caller_state.GetMemory());
     }
     // Pop the returning state from call stack.
-    exec_state.call_stack.pop_back();
+    if (this->IsExecStateRecyclingUsed()) exec_state.RecycleTopCallState();
+    else exec_state.call_stack.pop_back();
   }
 
 };
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <iostream>
+#include <limits>
 #include <utility>
 #include <memory>
+#include <optional>
 
 #include "emp/base/Ptr.hpp"
 #include "emp/base/vector.hpp"
@@ -12,6 +14,7 @@
 
 #include "../EventLibrary.hpp"
 #include "../inst/InstructionLibrary.hpp"
+#include "../utils/hash_utils.hpp"
 
 #include "BaseCPU.hpp"
 
@@ -32,19 +35,22 @@ template<
     emp::RankedSelector<>,
     emp::AdditiveCountdownRegulator<>
   >,
-  typename CUSTOM_COMPONENT_T=DefaultCustomComponent
+  typename CUSTOM_COMPONENT_T=DefaultCustomComponent,
+  typename SCHEDULER_T=sched::ConfigurableScheduler
 >
-class LinearProgramCPU : public BaseCPU<
+class LinearProgramCPU final : public BaseCPU<
   LinearProgramCPU<
     MEMORY_MODEL_T,
     // TAG_T,
     INST_ARGUMENT_T,
     MATCHBIN_T,
-    CUSTOM_COMPONENT_T
+    CUSTOM_COMPONENT_T,
+    SCHEDULER_T
   >,
   linprg::ExecState<MEMORY_MODEL_T>,
   typename MATCHBIN_T::tag_t,
-  CUSTOM_COMPONENT_T
+  CUSTOM_COMPONENT_T,
+  SCHEDULER_T
 > {
 public:
   // Forward declarations.
@@ -59,7 +65,8 @@ public:
     // TAG_T,
     INST_ARGUMENT_T,
     MATCHBIN_T,
-    CUSTOM_COMPONENT_T
+    CUSTOM_COMPONENT_T,
+    SCHEDULER_T
   >;
   // -- Control flow --
   using exec_state_t = linprg::ExecState<MEMORY_MODEL_T>;
@@ -72,14 +79,18 @@ public:
   // -- Program --
   using arg_t = INST_ARGUMENT_T;
   using module_t = Module;
+  struct SavedState;
+  using snapshot_t = SavedState; ///< Saved hardware state (see BaseCPU::Snapshot).
   using matchbin_t = MATCHBIN_T;
+  /// Regulator type of the matchbin (regulates how strongly each module matches).
+  using regulator_t = std::decay_t<decltype(std::declval<matchbin_t&>().GetRegulator(0))>;
   using tag_t = typename matchbin_t::tag_t;
   using program_t = sgp::cpu::linprg::LinearProgram<tag_t, arg_t>;
   // -- Memory model --
   using memory_model_t = MEMORY_MODEL_T;
   using memory_state_t = typename memory_model_t::memory_state_t;
   // -- Virtual hardware --
-  using base_hw_t = BaseCPU<this_t, exec_state_t, tag_t, CUSTOM_COMPONENT_T>;
+  using base_hw_t = BaseCPU<this_t, exec_state_t, tag_t, CUSTOM_COMPONENT_T, SCHEDULER_T>;
   using thread_t = typename base_hw_t::Thread;
   using event_lib_t = sgp::EventLibrary<this_t>;
   using event_t = typename base_hw_t::event_t;
@@ -133,12 +144,33 @@ public:
     bool InModule(size_t ip) const { return emp::Has(in_module, ip); }
   };
 
+  /// Saved hardware state (see BaseCPU::Snapshot): BaseCPU's state (threads, events, etc.), plus
+  /// the memory model (e.g., global memory) and the matchbin's module regulators.
+  struct SavedState : base_hw_t::BaseState {
+    memory_model_t memory_model;
+    emp::vector<regulator_t> regulators; ///< Regulator of each module (including, e.g., its timer).
+    size_t program_version=0;        ///< Program (see UpdateModules) that the state was saved with.
+  };
+
 protected:
+  friend base_hw_t; ///< BaseCPU calls ResetImpl.
+
+  static constexpr size_t NO_MODULE = std::numeric_limits<size_t>::max();
+
+  /// Is the given program position in the given module? (Same as modules[mp].InModule(ip), but
+  /// does not need a hash lookup.)
+  bool InModule(size_t mp, size_t ip) const {
+    return ip < inst_modules.size() && inst_modules[ip] == mp;
+  }
+
   inst_lib_t& inst_lib;           ///< Library of program instructions.
   flow_handler_t flow_handler;    ///< The flow handler manages the behavior of different types of execution flow.
+  bool default_flow_handlers = true; ///< Are the default flow handlers in place (see IsThreadLocalStep)?
   memory_model_t memory_model;    ///< The memory model manages any global memory state and specifies call state memory.
   program_t program;              ///< Program loaded on this execution stepper.
   emp::vector<module_t> modules;  ///< List of modules in program.
+  emp::vector<size_t> inst_modules; ///< Module that each program position belongs to (NO_MODULE if none).
+  emp::vector<bool> thread_local_insts; ///< Is the instruction at each program position THREAD_LOCAL?
   tag_t default_module_tag;       ///< What is the default tag to used for modules (in case the program doesn't specify)?
   emp::Random& random;            ///< Random number generator. (TODO - make this a smart pointer)
 
@@ -149,6 +181,7 @@ protected:
   }; // TODO - can we do a better job baking this in?
 
   size_t max_call_depth;          ///< Maximum size of a call stack.
+  size_t program_version=0;       ///< Incremented whenever the program's modules change (see RestoreState).
 
 
   // -- Internal helper functions --
@@ -358,6 +391,8 @@ public:
     memory_model(),
     program(),
     modules(),
+    inst_modules(),
+    thread_local_insts(),
     default_module_tag(),
     random(rnd),
     matchbin(rnd),
@@ -380,6 +415,9 @@ public:
   /// Reset loaded program.
   void ResetProgram() {
     modules.clear(); // Clear modules.
+    inst_modules.clear();
+    thread_local_insts.clear();
+    ++program_version;
     program.Clear(); // Clear program.
     ResetMatchBin(); // Reset matchbin.
   }
@@ -398,7 +436,7 @@ public:
   /// module mp.
   bool IsValidProgramPosition(size_t mp, size_t ip) const {
     if (mp < modules.size()) {
-      if (modules[mp].InModule(ip)) return true;
+      if (InModule(mp, ip)) return true;
     }
     return false;
   }
@@ -420,7 +458,7 @@ public:
         // std::cout << ">> MP=" << mp << "; IP=" << ip << std::endl;
         emp_assert(mp < GetNumModules(), "Invalid module pointer: ", mp);
         // Process current instruction (if any)!
-        if (modules[mp].InModule(ip)) {
+        if (InModule(mp, ip)) {
           // NOTE - should we increment the IP before or after executing?
           // Only BEFORE executing an instruction do we have any guarantees about
           // the state of our flow info. After processing an instruction, this
@@ -431,7 +469,7 @@ public:
           inst_lib.ProcessInst(hardware, program[ip]);
         } else if (
           (ip >= program.GetSize()) &&
-          modules[mp].InModule(0) &&
+          InModule(mp, 0) &&
           (modules[mp].end < modules[mp].begin)
         ) {
           // The instruction pointer is off the edge of the program.
@@ -457,15 +495,63 @@ public:
     }
   }
 
+  /// Does the given thread's next execution step only touch the thread's own state? (Lets BaseCPU
+  /// execute threads in parallel; see BaseCPU::SetParallelExecution.) Instructions are thread-local
+  /// if they have the THREAD_LOCAL property. Returning from a call is thread-local, as long as the
+  /// memory model's OnModuleReturn only touches the given memory (true of the default).
+  /// Closing a flow is never treated as thread-local: the step goes on to execute whatever comes
+  /// after the flow, which we cannot see without closing it.
+  /// NOTE: flow instructions (e.g., If, Close, Return) are only thread-local with the default flow
+  /// handlers, so custom flow handlers (see SetOpenFlowFun) cannot be used in parallel mode.
+  bool IsThreadLocalStep(thread_t& thread) const {
+    emp_assert(default_flow_handlers, "Custom flow handlers are not supported in parallel execution mode.");
+    const exec_state_t& exec_state = thread.GetExecState();
+    if (exec_state.call_stack.empty()) return true;
+    const call_state_t& call_state = exec_state.call_stack.back();
+    if (!call_state.IsFlow()) return true; // Return from call.
+    const flow_info_t& flow_info = call_state.flow_stack.back();
+    const module_t& module = modules[flow_info.mp];
+    if (InModule(flow_info.mp, flow_info.ip)) return thread_local_insts[flow_info.ip];
+    if ((flow_info.ip >= program.GetSize()) && InModule(flow_info.mp, 0) && (module.end < module.begin)) {
+      return thread_local_insts[0];
+    }
+    return false; // Close flow.
+  }
+
   /// Initialize thread by calling given module id on it.
   void InitThread(thread_t& thread, size_t module_id) {
     emp_assert(module_id < modules.size(), "Invalid module ID.");
     exec_state_t& state = thread.GetExecState();
     // Reset thread's call stack.
     if (state.call_stack.size()) {
-      state.Clear();
+      if (this->IsExecStateRecyclingUsed()) state.RecycleCallStack();
+      else state.Clear();
     }
     CallModule(module_id, state);
+    // If memory was staged for this thread before it was initialized (e.g., by Fork), it becomes
+    // the memory of the thread's first call state.
+    if (state.init_memory) {
+      if (state.call_stack.size()) state.GetTopCallState().memory = std::move(*state.init_memory);
+      state.init_memory.reset();
+    }
+  }
+
+  /// Apply the memory model's module-call semantics (OnModuleCall) from caller_mem to the given
+  /// spawned thread, as though caller_mem's owner called the spawned thread's module.
+  /// Spawned threads are initialized lazily (when activated); if the thread has not been
+  /// initialized yet, the call is applied to staged memory that InitThread will hand to the
+  /// thread's first call state.
+  void HandoffSpawnMemory(size_t thread_id, memory_state_t& caller_mem) {
+    emp_assert(thread_id < this->threads.size(), "Invalid thread id.", thread_id);
+    // NOTE: access thread storage directly; GetThread would initialize the thread.
+    thread_t thread(this->threads[thread_id]);
+    exec_state_t& state = thread.GetExecState();
+    if (thread.IsInitDeferred()) {
+      if (!state.init_memory) state.init_memory.emplace(memory_model.CreateMemoryState());
+      memory_model.OnModuleCall(caller_mem, *state.init_memory);
+    } else if (state.call_stack.size()) {
+      memory_model.OnModuleCall(caller_mem, state.GetTopCallState().GetMemory());
+    }
   }
 
   /// Get reference to random number generator used by this hardware.
@@ -474,18 +560,27 @@ public:
   flow_handler_t& GetFlowHandler() { return flow_handler; }
 
   /// Set open flow handler for given flow type.
+  /// Not supported in parallel execution mode (see IsThreadLocalStep).
   void SetOpenFlowFun(flow_t type, const fun_open_flow_t& fun) {
+    emp_assert(!this->IsParallelExecutionUsed(), "Custom flow handlers are not supported in parallel execution mode.");
     flow_handler[type].open_flow_fun = fun;
+    default_flow_handlers = false;
   }
 
   /// Set close flow handler for a given flow type.
+  /// Not supported in parallel execution mode (see IsThreadLocalStep).
   void SetCloseFlowFun(flow_t type, const fun_end_flow_t& fun) {
+    emp_assert(!this->IsParallelExecutionUsed(), "Custom flow handlers are not supported in parallel execution mode.");
     flow_handler[type].close_flow_fun = fun;
+    default_flow_handlers = false;
   }
 
   /// Set break flow handler for a given flow type.
+  /// Not supported in parallel execution mode (see IsThreadLocalStep).
   void SetBreakFlowFun(flow_t type, const fun_end_flow_t& fun) {
+    emp_assert(!this->IsParallelExecutionUsed(), "Custom flow handlers are not supported in parallel execution mode.");
     flow_handler[type].break_flow_fun = fun;
+    default_flow_handlers = false;
   }
 
   /// Find end of code block (i.e., internal flow control code segment).
@@ -529,9 +624,9 @@ public:
     exec_state_t& exec_state,
     bool circular=false
   ) {
-    emp::vector<size_t> matches(FindModuleMatch(tag));
-    if (matches.size()) {
-      CallModule(matches[0], exec_state, circular);
+    const std::optional<size_t> match(this->FindBestModuleMatch(tag));
+    if (match) {
+      CallModule(*match, exec_state, circular);
     }
   }
 
@@ -543,8 +638,12 @@ public:
   ) {
     emp_assert(module_id < modules.size());
     if (exec_state.call_stack.size() >= max_call_depth) return;
-    // Push new state onto stack.
-    exec_state.call_stack.emplace_back(memory_model.CreateMemoryState(), circular);
+    // Push new state onto stack (reusing a recycled call state if there is one).
+    if (exec_state.HasSpareCallState()) {
+      exec_state.ReuseCallState(circular);
+    } else {
+      exec_state.call_stack.emplace_back(memory_model.CreateMemoryState(), circular);
+    }
     module_t& module_info = modules[module_id];
     flow_handler.OpenFlow(
       *this,
@@ -574,7 +673,8 @@ public:
       );
     }
     // Pop the returning state from call stack.
-    exec_state.call_stack.pop_back();
+    if (this->IsExecStateRecyclingUsed()) exec_state.RecycleTopCallState();
+    else exec_state.call_stack.pop_back();
   }
 
   /// Set program for this hardware object.
@@ -597,6 +697,13 @@ public:
     // std::cout << "Update modules!" << std::endl;
     // Clear out the current modules.
     modules.clear();
+    inst_modules.clear();
+    ++program_version;
+    // Note which instructions are thread-local (see IsThreadLocalStep).
+    thread_local_insts.resize(program.GetSize());
+    for (size_t pos = 0; pos < program.GetSize(); ++pos) {
+      thread_local_insts[pos] = inst_lib.HasProperty(program[pos].GetID(), inst_prop_t::THREAD_LOCAL);
+    }
     // Do nothing if there aren't any instructions to look at.
     if (!program.GetSize()) return;
     // Scan program for module definitions.
@@ -649,6 +756,11 @@ public:
     for (size_t val : dangling_instructions) {
       modules.back().in_module.emplace(val);
     }
+    // Note which module each instruction belongs to (see InModule).
+    inst_modules.assign(program.GetSize(), NO_MODULE);
+    for (const module_t& module : modules) {
+      for (size_t pos : module.in_module) inst_modules[pos] = module.GetID();
+    }
     // Reset matchbin
     ResetMatchBin();
   }
@@ -679,6 +791,61 @@ public:
   matchbin_t & GetMatchBin() { return matchbin; }
   const matchbin_t & GetMatchBin() const { return matchbin; }
 
+  /// Get the matchbin regulator of the given module. (emp::MatchBin::GetRegulator is not const, but
+  /// it does not modify the matchbin.)
+  const regulator_t& GetRegulator(size_t uid) const {
+    return const_cast<matchbin_t&>(matchbin).GetRegulator(uid);
+  }
+
+  /// Save LinearProgramCPU's part of a snapshot (see BaseCPU::Snapshot).
+  void SaveState(snapshot_t& snapshot) const {
+    snapshot.memory_model = memory_model;
+    snapshot.regulators.resize(modules.size());
+    for (size_t i = 0; i < modules.size(); ++i) snapshot.regulators[i] = GetRegulator(i);
+    snapshot.program_version = program_version;
+  }
+
+  /// Restore LinearProgramCPU's part of a snapshot (see BaseCPU::Restore). The program must not have
+  /// changed since the snapshot was taken (modules are not recompiled).
+  void RestoreState(const snapshot_t& snapshot) {
+    emp_assert(snapshot.program_version == program_version, "Program changed since snapshot was taken.");
+    emp_assert(snapshot.regulators.size() == modules.size());
+    memory_model = snapshot.memory_model;
+    for (size_t i = 0; i < modules.size(); ++i) matchbin.SetRegulator(i, snapshot.regulators[i]);
+  }
+
+  /// Hash hardware-wide state that affects execution (see BaseCPU::SetCycleDetection): the memory
+  /// model's state (e.g., global memory) and module regulators. (Only available if the memory
+  /// model can hash its state.)
+  template<typename MEM_MODEL_T=memory_model_t>
+  auto HashState() const -> decltype(std::declval<const MEM_MODEL_T&>().HashState(), size_t()) {
+    size_t hash = memory_model.HashState();
+    for (size_t i = 0; i < modules.size(); ++i) hash = utils::HashRegulator(hash, GetRegulator(i));
+    return hash;
+  }
+
+  /// Hash an execution state (see BaseCPU::SetCycleDetection): each call's memory and flow stack.
+  template<typename MEM_MODEL_T=memory_model_t>
+  auto HashExecState(const exec_state_t& state) const -> decltype(
+    std::declval<const MEM_MODEL_T&>().HashMemoryState(std::declval<const memory_state_t&>()),
+    size_t()
+  ) {
+    size_t hash = state.call_stack.size();
+    for (const call_state_t& call_state : state.call_stack) {
+      hash = utils::HashCombine(hash, call_state.circular);
+      hash = utils::HashCombine(hash, memory_model.HashMemoryState(call_state.memory));
+      hash = utils::HashCombine(hash, call_state.flow_stack.size());
+      for (const flow_info_t& flow : call_state.flow_stack) {
+        hash = utils::HashCombine(hash, flow.type);
+        hash = utils::HashCombine(hash, flow.mp);
+        hash = utils::HashCombine(hash, flow.ip);
+        hash = utils::HashCombine(hash, flow.begin);
+        hash = utils::HashCombine(hash, flow.end);
+      }
+    }
+    return hash;
+  }
+
   /// Print information on loaded modules.
   void PrintModules(std::ostream& os=std::cout) const {
     os << "Modules: [";
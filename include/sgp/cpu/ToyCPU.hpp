@@ -17,18 +17,22 @@ struct ExecState {
 
 } // End toy_cpu_impl
 
-template<typename CUSTOM_COMPONET_T=DefaultCustomComponent>
-class ToyCPU : public BaseCPU<
-  ToyCPU<CUSTOM_COMPONET_T>, /* DERIVED_T */
+template<
+  typename CUSTOM_COMPONET_T=DefaultCustomComponent,
+  typename SCHEDULER_T=sched::ConfigurableScheduler
+>
+class ToyCPU final : public BaseCPU<
+  ToyCPU<CUSTOM_COMPONET_T, SCHEDULER_T>, /* DERIVED_T */
   toy_cpu_impl::ExecState,   /* EXEC_STATE_T */
   size_t,                         /* TAG_T */
-  CUSTOM_COMPONET_T               /* CUSTOM_COMPONENT_T */
+  CUSTOM_COMPONET_T,              /* CUSTOM_COMPONENT_T */
+  SCHEDULER_T                     /* SCHEDULER_T */
 > {
 public:
 
-  using this_t = ToyCPU<CUSTOM_COMPONET_T>;
+  using this_t = ToyCPU<CUSTOM_COMPONET_T, SCHEDULER_T>;
   using exec_state_t = toy_cpu_impl::ExecState;  ///< REQUIRED. Thread state information.
-  using base_hw_t = BaseCPU< this_t, exec_state_t, size_t, CUSTOM_COMPONET_T>;
+  using base_hw_t = BaseCPU< this_t, exec_state_t, size_t, CUSTOM_COMPONET_T, SCHEDULER_T>;
   using program_t = emp::vector<size_t>;     ///< REQUIRED. What types of programs does this stepper execute?
   using tag_t = size_t;                      ///< REQUIRED. What does this stepper use to reference different modules?
   using event_lib_t = typename base_hw_t::event_lib_t;
@@ -69,29 +73,38 @@ public:
 
   /// REQUIRED
   emp::vector<size_t> FindModuleMatch(const tag_t& tag, size_t N) {
+    emp::vector<size_t> matches;
+    FindModuleMatch(tag, N, matches);
+    return matches;
+  }
+
+  /// OPTIONAL (lets BaseCPU spawn threads by tag without allocating)
+  void FindModuleMatch(const tag_t& tag, size_t N, emp::vector<size_t>& matches) {
     // tag_t => size_t
     // Let tag % program.size() index into program.
-    emp::vector<size_t> matches;
-    if (!program.size()) { return matches; }
+    matches.clear();
+    if (!program.size()) { return; }
     for (size_t i = 0; i < N; ++i) {
       matches.emplace_back((tag + i) % program.size());
     }
-    return matches;
   }
 
   /// Module ids index into program directly (each module is a size_t)
   /// REQUIRED
   void InitThread(thread_t& thread, size_t module_id) {
     emp_assert(module_id < program.size());
-    thread.exec_state.value = program[module_id];
+    thread.GetExecState().value = program[module_id];
   }
 
+  /// OPTIONAL (lets BaseCPU execute threads in parallel; toy steps only touch their own thread)
+  bool IsThreadLocalStep(thread_t& thread) const { return true; }
+
   /// REQUIRED
   void SingleExecutionStep(this_t& hw, thread_t& thread) {
     if (thread.GetExecState().value == 0) {
       thread.SetDead();
     } else {
-      thread.exec_state.value -= 1;
+      thread.GetExecState().value -= 1;
     }
   }
 
@@ -23,6 +23,14 @@ struct CallState {
     circular(_circular)
   { ; }
 
+  /// Reset this call state for reuse: clear memory (via MEMORY_STATE_T::Clear) and the flow
+  /// stack, keeping any allocated capacity.
+  void Clear() {
+    memory.Clear();
+    flow_stack.clear();
+    circular = false;
+  }
+
   bool IsFlow() const { return !flow_stack.empty(); }
 
   emp::vector<FlowInfo>& GetFlowStack() { return flow_stack; }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <optional>
+#include <utility>
+
 #include "CallState.hpp"
 
 namespace sgp::cpu::linprg {
@@ -10,10 +13,49 @@ struct ExecState {
   using memory_state_t = typename MEMORY_MODEL_T::memory_state_t;
   using call_state_t = CallState<memory_state_t>;
   emp::vector<call_state_t> call_stack;   ///< Program call stack.
+  emp::vector<call_state_t> spare_call_states; ///< Recycled (cleared) call states, ready for reuse.
+  std::optional<memory_state_t> init_memory; ///< (Optional) memory to initialize the first call state with.
 
   /// Empty out the call stack.
   void Clear() { call_stack.clear(); }
-  void Reset() { call_stack.clear(); }
+  void Reset() {
+    call_stack.clear();
+    spare_call_states.clear();
+    init_memory.reset();
+  }
+
+  /// Reset, recycling all call states on the call stack (see RecycleTopCallState).
+  void Recycle() {
+    RecycleCallStack();
+    init_memory.reset();
+  }
+
+  /// Empty out the call stack, recycling its call states (see RecycleTopCallState).
+  void RecycleCallStack() {
+    while (call_stack.size()) RecycleTopCallState();
+  }
+
+  /// Pop the top call state off of the call stack, clearing it (see CallState::Clear) and keeping
+  /// it (along with its allocated memory and flow stack capacity) for reuse (see ReuseCallState).
+  void RecycleTopCallState() {
+    emp_assert(call_stack.size(), "Cannot recycle call state from empty call stack.");
+    call_stack.back().Clear();
+    spare_call_states.emplace_back(std::move(call_stack.back()));
+    call_stack.pop_back();
+  }
+
+  /// Is there a recycled call state available for reuse?
+  bool HasSpareCallState() const { return !spare_call_states.empty(); }
+
+  /// Push a recycled call state (with cleared memory and no flow) onto the call stack.
+  /// Requires a spare call state (see HasSpareCallState).
+  call_state_t& ReuseCallState(bool circular) {
+    emp_assert(spare_call_states.size(), "No spare call states to reuse.");
+    call_stack.emplace_back(std::move(spare_call_states.back()));
+    spare_call_states.pop_back();
+    call_stack.back().circular = circular;
+    return call_stack.back();
+  }
 
   /// Get a reference to the current (top) call state on the call stack.
   /// Requires the call stack to be not empty.
@@ -8,6 +8,8 @@
 #include "emp/datastructs/set_utils.hpp"
 #include "emp/datastructs/map_utils.hpp"
 
+#include "../../utils/hash_utils.hpp"
+
 namespace sgp::cpu::mem {
 
 // TODO - make on return/on call re-configurable
@@ -44,6 +46,16 @@ public:
 
     BasicMemoryState(const BasicMemoryState&) = default;
     BasicMemoryState(BasicMemoryState&&) = default;
+    BasicMemoryState& operator=(const BasicMemoryState&) = default;
+    BasicMemoryState& operator=(BasicMemoryState&&) = default;
+
+    /// Clear all memory buffers. Buffers keep their allocated buckets, so a cleared memory state
+    /// is cheaper to refill than a new one.
+    void Clear() {
+      working_mem.clear();
+      input_mem.clear();
+      output_mem.clear();
+    }
 
     /// Set value at given key in working memory. No questions asked.
     void SetWorking(int address, double value) {
@@ -166,6 +178,21 @@ public:
     PrintMemoryBuffer(global_mem, os);
   }
 
+  /// Hash the contents of a single memory buffer.
+  size_t HashMemoryBuffer(const mem_buffer_t& buffer) const {
+    return utils::HashUnorderedMap(buffer);
+  }
+
+  /// Hash a memory state (working, input, and output memory).
+  size_t HashMemoryState(const memory_state_t& state) const {
+    size_t hash = HashMemoryBuffer(state.working_mem);
+    hash = utils::HashCombine(hash, HashMemoryBuffer(state.input_mem));
+    return utils::HashCombine(hash, HashMemoryBuffer(state.output_mem));
+  }
+
+  /// Hash the state of memory (global memory).
+  size_t HashState() const { return HashMemoryBuffer(global_mem); }
+
   mem_buffer_t& GetGlobalBuffer() { return global_mem; }
   const mem_buffer_t& GetGlobalBuffer() const { return global_mem; }
 
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Resizable array that stores its elements in fixed-size chunks of CHUNK_SIZE elements.
+/// Elements never move: growing the array only allocates new chunks (existing elements are never
+/// copied or moved), so references to elements remain valid until the array shrinks past them.
+/// Growing by one element costs O(1) (plus one chunk allocation every CHUNK_SIZE elements).
+///
+/// Shrinking keeps allocated chunks that are still (partially) in use; elements dropped from a
+/// kept chunk are reset to T().
+template<typename T, size_t CHUNK_BITS=6>
+class ChunkedArray {
+public:
+  using value_t = T;
+  static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+
+protected:
+  static constexpr size_t CHUNK_MASK = CHUNK_SIZE - 1;
+
+  emp::vector<std::unique_ptr<T[]>> chunks;  ///< Element storage.
+  size_t count=0;                            ///< Number of elements.
+
+public:
+  ChunkedArray(size_t n=0) : chunks(), count(0) { Resize(n); }
+
+  ChunkedArray(const ChunkedArray& in) : chunks(), count(0) { *this = in; }
+  ChunkedArray(ChunkedArray&& in) = default;
+
+  ChunkedArray& operator=(const ChunkedArray& in) {
+    if (this == &in) return *this;
+    Resize(in.count);
+    for (size_t i = 0; i < count; ++i) (*this)[i] = in[i];
+    return *this;
+  }
+  ChunkedArray& operator=(ChunkedArray&& in) = default;
+
+  size_t GetSize() const { return count; }
+  size_t size() const { return count; }
+
+  /// Get the number of elements that fit in currently allocated chunks.
+  size_t GetCapacity() const { return chunks.size() * CHUNK_SIZE; }
+
+  /// Set the number of elements. New elements are value-initialized.
+  void Resize(size_t n) {
+    const size_t num_chunks = (n + CHUNK_MASK) >> CHUNK_BITS;
+    // Reset elements dropped from chunks that we are keeping.
+    const size_t kept_end = std::min(count, num_chunks * CHUNK_SIZE);
+    for (size_t i = n; i < kept_end; ++i) (*this)[i] = T();
+    chunks.resize(std::min(chunks.size(), num_chunks));
+    while (chunks.size() < num_chunks) chunks.emplace_back(std::make_unique<T[]>(CHUNK_SIZE));
+    count = n;
+  }
+
+  T& operator[](size_t i) {
+    emp_assert(i < count, i, count);
+    return chunks[i >> CHUNK_BITS][i & CHUNK_MASK];
+  }
+
+  const T& operator[](size_t i) const {
+    emp_assert(i < count, i, count);
+    return chunks[i >> CHUNK_BITS][i & CHUNK_MASK];
+  }
+};
+
+} // End sgp::cpu::sched namespace
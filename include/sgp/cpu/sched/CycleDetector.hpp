@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+
+namespace sgp::cpu::sched {
+
+/// Detects when a sequence of state hashes (one per observation) starts repeating, using Brent's
+/// cycle detection algorithm: the detector keeps one checkpoint hash, compares each new hash with
+/// it, and moves the checkpoint forward after 1, 2, 4, 8, ... observations. So, each observation
+/// costs O(1) (one comparison), memory is O(1), and a cycle of length L that starts after T
+/// observations is detected within about 2 * max(T, L) + L observations.
+///
+/// Detection relies on hashes: two different states with the same hash look like a recurrence.
+class CycleDetector {
+protected:
+  size_t checkpoint=0;      ///< Hash of the checkpointed state.
+  size_t power=1;           ///< Number of observations before the checkpoint moves forward.
+  size_t num_since=0;       ///< Number of observations since the checkpoint.
+  size_t cycle_length=0;    ///< Length of the detected cycle (0 => none detected).
+  bool has_checkpoint=false;
+
+public:
+  /// Forget all observations (and any detected cycle).
+  void Reset() {
+    checkpoint = 0;
+    power = 1;
+    num_since = 0;
+    cycle_length = 0;
+    has_checkpoint = false;
+  }
+
+  /// Observe the next state's hash.
+  /// @return true if a cycle has been detected (by this observation, or an earlier one).
+  bool Observe(size_t hash) {
+    if (cycle_length) return true;
+    if (!has_checkpoint) {
+      checkpoint = hash;
+      has_checkpoint = true;
+      return false;
+    }
+    ++num_since;
+    if (hash == checkpoint) {
+      cycle_length = num_since;
+      return true;
+    }
+    if (num_since == power) {
+      checkpoint = hash;
+      power *= 2;
+      num_since = 0;
+    }
+    return false;
+  }
+
+  /// Has a cycle been detected?
+  bool IsCycleDetected() const { return cycle_length > 0; }
+
+  /// Get the length (in observations) of the detected cycle (0 if none has been detected).
+  size_t GetCycleLength() const { return cycle_length; }
+};
+
+} // End sgp::cpu::sched namespace
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+#include "FixedVector.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Set of integer ids drawn from [0:capacity) with O(1) membership tests, insertion, and
+/// removal (a 'sparse set').
+///
+/// Members are stored contiguously in 'dense', and 'sparse' maps each possible id to its
+/// position in 'dense' (or npos if the id is not a member). Removal swaps the last member into
+/// the removed member's position, so iteration order is NOT insertion order.
+/// Once storage is sized (Resize), Insert/Erase/Has/Clear never allocate.
+/// With CAPACITY > 0, storage is fixed (inline) and capacity can never exceed CAPACITY.
+template<size_t CAPACITY=0>
+class BasicDenseIDSet {
+public:
+  using ids_t = Storage<size_t, CAPACITY>;
+  using const_iterator = typename ids_t::const_iterator;
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+protected:
+  ids_t dense;  ///< Member ids (contiguous, unordered).
+  ids_t sparse; ///< For each possible id, its position in dense (or npos).
+
+public:
+  BasicDenseIDSet(size_t capacity=0) : dense(), sparse(capacity, npos) {
+    dense.reserve(capacity);
+  }
+
+  /// Get the number of ids that can be tracked by this set (valid ids are [0:capacity)).
+  size_t GetCapacity() const { return sparse.size(); }
+
+  /// Set the number of ids that can be tracked by this set. Shrinking the capacity removes any
+  /// member ids >= the new capacity.
+  void Resize(size_t capacity) {
+    if (capacity < sparse.size()) {
+      // Iterate backwards so that swap-removal never moves an unchecked member behind us.
+      for (size_t i = dense.size(); i-- > 0;) {
+        if (dense[i] >= capacity) Erase(dense[i]);
+      }
+    } else if (dense.capacity() < capacity) {
+      // Grow geometrically to keep repeated single-id growth amortized O(1).
+      dense.reserve(std::max(capacity, 2 * dense.capacity()));
+    }
+    sparse.resize(capacity, npos);
+  }
+
+  /// Get the number of ids in this set.
+  size_t GetSize() const { return dense.size(); }
+  size_t size() const { return dense.size(); }
+
+  /// Is this set empty?
+  bool IsEmpty() const { return dense.empty(); }
+  bool empty() const { return dense.empty(); }
+
+  /// Is the given id a member of this set?
+  bool Has(size_t id) const { return id < sparse.size() && sparse[id] != npos; }
+
+  /// Add id to this set. Returns false if id was already a member.
+  bool Insert(size_t id) {
+    emp_assert(id < sparse.size(), "ID exceeds set capacity.", id, sparse.size());
+    if (sparse[id] != npos) return false;
+    sparse[id] = dense.size();
+    dense.emplace_back(id);
+    return true;
+  }
+
+  /// Remove id from this set. Returns false if id was not a member.
+  bool Erase(size_t id) {
+    if (!Has(id)) return false;
+    const size_t pos = sparse[id];
+    const size_t last_id = dense.back();
+    dense[pos] = last_id;
+    sparse[last_id] = pos;
+    dense.pop_back();
+    sparse[id] = npos;
+    return true;
+  }
+
+  /// Remove all members (O(size), not O(capacity)).
+  void Clear() {
+    for (size_t id : dense) sparse[id] = npos;
+    dense.clear();
+  }
+
+  /// Get the i'th member id (in storage order).
+  size_t operator[](size_t i) const {
+    emp_assert(i < dense.size());
+    return dense[i];
+  }
+
+  const_iterator begin() const { return dense.cbegin(); }
+  const_iterator end() const { return dense.cend(); }
+
+  /// Get a const reference to member ids as a contiguous vector.
+  const ids_t& GetIDs() const { return dense; }
+};
+
+using DenseIDSet = BasicDenseIDSet<>;
+
+} // End sgp::cpu::sched namespace
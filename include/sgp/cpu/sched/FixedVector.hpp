@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Vector with a fixed maximum size (CAPACITY), stored inline in a std::array: a FixedVector
+/// never allocates, and it lives wherever its owner lives.
+/// Provides the subset of the std::vector interface that the scheduling structures use.
+/// Elements beyond size() are always default-valued (resize and pop_back reset elements that
+/// they drop).
+template<typename T, size_t CAPACITY>
+class FixedVector {
+public:
+  static_assert(CAPACITY > 0, "FixedVector capacity must be > 0.");
+  using value_type = T;
+  using iterator = typename std::array<T, CAPACITY>::iterator;
+  using const_iterator = typename std::array<T, CAPACITY>::const_iterator;
+
+protected:
+  std::array<T, CAPACITY> data;  ///< Element storage.
+  size_t count=0;                ///< Number of elements.
+
+public:
+  FixedVector() : data(), count(0) { ; }
+  FixedVector(size_t n, const T& val=T()) : data(), count(0) { resize(n, val); }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  static constexpr size_t capacity() { return CAPACITY; }
+
+  /// Storage is fixed; reserve only checks that n elements fit.
+  void reserve(size_t n) { emp_assert(n <= CAPACITY, n, CAPACITY); }
+
+  void resize(size_t n, const T& val=T()) {
+    emp_assert(n <= CAPACITY, n, CAPACITY);
+    for (size_t i = count; i < n; ++i) data[i] = val;
+    for (size_t i = n; i < count; ++i) data[i] = T();
+    count = n;
+  }
+
+  T& operator[](size_t i) {
+    emp_assert(i < count, i, count);
+    return data[i];
+  }
+
+  const T& operator[](size_t i) const {
+    emp_assert(i < count, i, count);
+    return data[i];
+  }
+
+  T& front() { return (*this)[0]; }
+  const T& front() const { return (*this)[0]; }
+  T& back() { return (*this)[count - 1]; }
+  const T& back() const { return (*this)[count - 1]; }
+
+  template<typename... ARGS>
+  T& emplace_back(ARGS&&... args) {
+    emp_assert(count < CAPACITY, "FixedVector is full.", CAPACITY);
+    data[count] = T(std::forward<ARGS>(args)...);
+    return data[count++];
+  }
+
+  void push_back(const T& val) { emplace_back(val); }
+
+  void pop_back() {
+    emp_assert(count, "Cannot pop from empty FixedVector.");
+    data[--count] = T();
+  }
+
+  void clear() { resize(0); }
+
+  void swap(FixedVector& other) {
+    std::swap(data, other.data);
+    std::swap(count, other.count);
+  }
+
+  iterator begin() { return data.begin(); }
+  iterator end() { return data.begin() + count; }
+  const_iterator begin() const { return data.cbegin(); }
+  const_iterator end() const { return data.cbegin() + count; }
+  const_iterator cbegin() const { return data.cbegin(); }
+  const_iterator cend() const { return data.cbegin() + count; }
+};
+
+/// Storage used by the scheduling structures for per-id data: an emp::vector if CAPACITY is 0
+/// (dynamic capacity), or a FixedVector (stored inline) otherwise.
+template<typename T, size_t CAPACITY>
+using Storage = std::conditional_t<CAPACITY == 0, emp::vector<T>, FixedVector<T, CAPACITY>>;
+
+} // End sgp::cpu::sched namespace
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+#include "FixedVector.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Binary heap over integer ids drawn from [0:capacity), each with an associated key.
+/// Because the heap tracks the position of every id, membership tests are O(1), and keys can
+/// be updated or ids removed from anywhere in the heap in O(log n).
+///
+/// Ordering follows std::priority_queue conventions: with COMPARE_T=std::less<KEY_T> (default),
+/// Top() is the id with the largest key (i.e., a max heap); with std::greater<KEY_T>, Top() is the
+/// id with the smallest key (i.e., a min heap).
+/// Once storage is sized (Resize), no operation allocates.
+/// With CAPACITY > 0, storage is fixed (inline) and capacity can never exceed CAPACITY.
+template<typename KEY_T, typename COMPARE_T=std::less<KEY_T>, size_t CAPACITY=0>
+class IndexedHeap {
+public:
+  using key_t = KEY_T;
+  using compare_t = COMPARE_T;
+  using ids_t = Storage<size_t, CAPACITY>;
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+protected:
+  ids_t heap;                      ///< Heap-ordered ids.
+  ids_t pos;                       ///< For each possible id, its position in heap (or npos).
+  Storage<key_t, CAPACITY> keys;   ///< For each possible id, its key (only meaningful for members).
+  compare_t compare;
+
+  /// Should the id at heap position a sit above the id at heap position b?
+  bool Above(size_t a, size_t b) const { return compare(keys[heap[b]], keys[heap[a]]); }
+
+  void Swap(size_t a, size_t b) {
+    std::swap(heap[a], heap[b]);
+    pos[heap[a]] = a;
+    pos[heap[b]] = b;
+  }
+
+  void SiftUp(size_t i) {
+    while (i > 0) {
+      const size_t parent = (i - 1) / 2;
+      if (!Above(i, parent)) break;
+      Swap(i, parent);
+      i = parent;
+    }
+  }
+
+  void SiftDown(size_t i) {
+    const size_t n = heap.size();
+    while (true) {
+      const size_t left = 2 * i + 1;
+      if (left >= n) break;
+      const size_t right = left + 1;
+      const size_t child = (right < n && Above(right, left)) ? right : left;
+      if (!Above(child, i)) break;
+      Swap(i, child);
+      i = child;
+    }
+  }
+
+public:
+  IndexedHeap(size_t capacity=0, const compare_t& cmp=compare_t())
+    : heap(), pos(capacity, npos), keys(capacity), compare(cmp)
+  {
+    heap.reserve(capacity);
+  }
+
+  /// Get the number of ids that can be tracked by this heap (valid ids are [0:capacity)).
+  size_t GetCapacity() const { return pos.size(); }
+
+  /// Set the number of ids that can be tracked by this heap. Shrinking the capacity removes any
+  /// member ids >= the new capacity.
+  void Resize(size_t capacity) {
+    if (capacity < pos.size()) {
+      for (size_t id = capacity; id < pos.size(); ++id) Remove(id);
+    } else if (heap.capacity() < capacity) {
+      heap.reserve(std::max(capacity, 2 * heap.capacity()));
+    }
+    pos.resize(capacity, npos);
+    keys.resize(capacity);
+  }
+
+  size_t GetSize() const { return heap.size(); }
+  size_t size() const { return heap.size(); }
+  bool IsEmpty() const { return heap.empty(); }
+  bool empty() const { return heap.empty(); }
+
+  /// Is the given id in this heap?
+  bool Has(size_t id) const { return id < pos.size() && pos[id] != npos; }
+
+  /// Get the key associated with the given (member) id.
+  const key_t& GetKey(size_t id) const {
+    emp_assert(Has(id), "ID not in heap.", id);
+    return keys[id];
+  }
+
+  /// Get the id at the top of the heap.
+  size_t Top() const {
+    emp_assert(heap.size(), "Heap is empty.");
+    return heap.front();
+  }
+
+  /// Get the key of the id at the top of the heap.
+  const key_t& TopKey() const {
+    emp_assert(heap.size(), "Heap is empty.");
+    return keys[heap.front()];
+  }
+
+  /// Add id (with given key) to the heap. Id must not already be in the heap.
+  void Push(size_t id, const key_t& key) {
+    emp_assert(id < pos.size(), "ID exceeds heap capacity.", id, pos.size());
+    emp_assert(!Has(id), "ID already in heap.", id);
+    keys[id] = key;
+    pos[id] = heap.size();
+    heap.emplace_back(id);
+    SiftUp(heap.size() - 1);
+  }
+
+  /// Change the key of an id already in the heap.
+  void Update(size_t id, const key_t& key) {
+    emp_assert(Has(id), "ID not in heap.", id);
+    keys[id] = key;
+    SiftUp(pos[id]);
+    SiftDown(pos[id]);
+  }
+
+  /// Remove id from the heap. Returns false if id was not in the heap.
+  bool Remove(size_t id) {
+    if (!Has(id)) return false;
+    const size_t i = pos[id];
+    const size_t last = heap.size() - 1;
+    if (i != last) {
+      Swap(i, last);
+      heap.pop_back();
+      pos[id] = npos;
+      SiftUp(i);
+      SiftDown(i);
+    } else {
+      heap.pop_back();
+      pos[id] = npos;
+    }
+    return true;
+  }
+
+  /// Remove and return the id at the top of the heap.
+  size_t Pop() {
+    const size_t id = Top();
+    Remove(id);
+    return id;
+  }
+
+  /// Remove all ids from the heap (O(size), not O(capacity)).
+  void Clear() {
+    for (size_t id : heap) pos[id] = npos;
+    heap.clear();
+  }
+
+  /// Get member ids in heap (storage) order.
+  const ids_t& GetIDs() const { return heap; }
+};
+
+} // End sgp::cpu::sched namespace
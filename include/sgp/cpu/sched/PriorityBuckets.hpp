@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+#include "FixedVector.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Integer ids drawn from [0:capacity), each queued at one of up to MAX_LEVELS integer priority
+/// levels. Each level is an intrusive FIFO queue (linked through per-id storage), and a bitmap
+/// tracks which levels are occupied, so finding the highest/lowest-priority id, adding an id, and
+/// removing any id are all O(1).
+///
+/// Ties (ids at the same level) are broken by arrival order: Max* operations choose the id that
+/// has been at the highest level the longest, and Min* operations choose the id that arrived at
+/// the lowest level most recently.
+/// Once storage is sized (Resize), no operation allocates.
+/// With CAPACITY > 0, storage is fixed (inline) and capacity can never exceed CAPACITY.
+template<size_t CAPACITY=0>
+class BasicPriorityBuckets {
+public:
+  static constexpr size_t MAX_LEVELS = 64;
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+protected:
+  struct Link {
+    size_t prev=npos;
+    size_t next=npos;
+    size_t level=npos;  ///< Level of this id (npos if not a member).
+  };
+
+  struct Bucket {
+    size_t head=npos;
+    size_t tail=npos;
+  };
+
+  Storage<Link, CAPACITY> links;                        ///< For each possible id, its links.
+  Storage<Bucket, CAPACITY ? MAX_LEVELS : 0> buckets;  ///< One FIFO queue per level.
+  uint64_t occupied=0;          ///< Bit i is set if level i is non-empty.
+  size_t count=0;               ///< Number of members.
+
+  static size_t HighestBit(uint64_t bits) {
+    emp_assert(bits);
+    #if defined(__GNUC__) || defined(__clang__)
+    return 63 - (size_t)__builtin_clzll(bits);
+    #else
+    size_t i = 63;
+    while (!(bits >> i)) --i;
+    return i;
+    #endif
+  }
+
+  static size_t LowestBit(uint64_t bits) {
+    emp_assert(bits);
+    #if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(bits);
+    #else
+    size_t i = 0;
+    while (!((bits >> i) & 1)) ++i;
+    return i;
+    #endif
+  }
+
+public:
+  BasicPriorityBuckets(size_t capacity=0, size_t num_levels=MAX_LEVELS)
+    : links(capacity), buckets(num_levels)
+  {
+    emp_assert(num_levels && num_levels <= MAX_LEVELS, num_levels);
+  }
+
+  /// Get the number of ids that can be tracked (valid ids are [0:capacity)).
+  size_t GetCapacity() const { return links.size(); }
+
+  /// Set the number of ids that can be tracked. Shrinking the capacity removes any members >=
+  /// the new capacity.
+  void Resize(size_t capacity) {
+    for (size_t id = capacity; id < links.size(); ++id) Remove(id);
+    links.resize(capacity);
+  }
+
+  /// Get the number of priority levels (valid levels are [0:num_levels)).
+  size_t GetNumLevels() const { return buckets.size(); }
+
+  /// Set the number of priority levels. Removes all members.
+  void SetNumLevels(size_t num_levels) {
+    emp_assert(num_levels && num_levels <= MAX_LEVELS, num_levels);
+    Clear();
+    buckets.resize(num_levels);
+  }
+
+  size_t GetSize() const { return count; }
+  size_t size() const { return count; }
+  bool IsEmpty() const { return count == 0; }
+  bool empty() const { return count == 0; }
+
+  /// Is the given id a member?
+  bool Has(size_t id) const { return id < links.size() && links[id].level != npos; }
+
+  /// Get the level of the given (member) id.
+  size_t GetLevel(size_t id) const {
+    emp_assert(Has(id), "ID not a member.", id);
+    return links[id].level;
+  }
+
+  /// Add id at the back of the queue for the given level. Id must not already be a member.
+  void Push(size_t id, size_t level) {
+    emp_assert(id < links.size(), "ID exceeds capacity.", id, links.size());
+    emp_assert(!Has(id), "ID already a member.", id);
+    emp_assert(level < buckets.size(), "Invalid level.", level);
+    Bucket& bucket = buckets[level];
+    Link& link = links[id];
+    link.prev = bucket.tail;
+    link.next = npos;
+    link.level = level;
+    if (bucket.tail != npos) links[bucket.tail].next = id;
+    else bucket.head = id;
+    bucket.tail = id;
+    occupied |= (uint64_t(1) << level);
+    ++count;
+  }
+
+  /// Remove id. Returns false if id was not a member.
+  bool Remove(size_t id) {
+    if (!Has(id)) return false;
+    Link& link = links[id];
+    Bucket& bucket = buckets[link.level];
+    if (link.prev != npos) links[link.prev].next = link.next;
+    else bucket.head = link.next;
+    if (link.next != npos) links[link.next].prev = link.prev;
+    else bucket.tail = link.prev;
+    if (bucket.head == npos) occupied &= ~(uint64_t(1) << link.level);
+    link = Link();
+    --count;
+    return true;
+  }
+
+  /// Move a member id to the given level (to the back of its queue) if its level changed.
+  void Update(size_t id, size_t level) {
+    emp_assert(Has(id), "ID not a member.", id);
+    if (links[id].level == level) return;
+    Remove(id);
+    Push(id, level);
+  }
+
+  /// Get the highest occupied level. Requires a non-empty set.
+  size_t GetMaxLevel() const {
+    emp_assert(count, "Empty.");
+    return HighestBit(occupied);
+  }
+
+  /// Get the lowest occupied level. Requires a non-empty set.
+  size_t GetMinLevel() const {
+    emp_assert(count, "Empty.");
+    return LowestBit(occupied);
+  }
+
+  /// Get the id at the front of the highest occupied level.
+  size_t GetMaxID() const { return buckets[GetMaxLevel()].head; }
+
+  /// Get the id at the back of the lowest occupied level.
+  size_t GetMinID() const { return buckets[GetMinLevel()].tail; }
+
+  /// Remove and return GetMaxID().
+  size_t PopMax() {
+    const size_t id = GetMaxID();
+    Remove(id);
+    return id;
+  }
+
+  /// Remove and return GetMinID().
+  size_t PopMin() {
+    const size_t id = GetMinID();
+    Remove(id);
+    return id;
+  }
+
+  /// Remove all members (O(size + num levels), not O(capacity)).
+  void Clear() {
+    for (Bucket& bucket : buckets) {
+      for (size_t id = bucket.head; id != npos;) {
+        const size_t next = links[id].next;
+        links[id] = Link();
+        id = next;
+      }
+      bucket = Bucket();
+    }
+    occupied = 0;
+    count = 0;
+  }
+};
+
+using PriorityBuckets = BasicPriorityBuckets<>;
+
+} // End sgp::cpu::sched namespace
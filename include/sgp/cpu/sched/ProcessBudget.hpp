@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <limits>
+#include <optional>
+
+#include "emp/base/assert.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Budget for BaseCPU::ProcessFor: a limit on the number of instructions (thread execution steps)
+/// executed, the number of steps (SingleProcess calls) taken, and/or the wall-clock time spent.
+/// Processing stops as soon as any limit is reached.
+struct ProcessBudget {
+  using wall_clock_t = std::chrono::steady_clock;
+  using time_point_t = wall_clock_t::time_point;
+
+  static constexpr size_t UNLIMITED = std::numeric_limits<size_t>::max();
+  static constexpr size_t DEFAULT_CLOCK_CHECK_INTERVAL = 1024;
+
+  size_t max_instructions=UNLIMITED;  ///< Maximum number of instructions to execute.
+  size_t max_steps=UNLIMITED;         ///< Maximum number of steps to take.
+  std::optional<time_point_t> deadline; ///< Wall-clock time by which to stop (if any).
+  /// The deadline is checked (i.e., the clock is read) once every this many instructions (or
+  /// steps), so checking is cheap, but processing may run past the deadline by this much work.
+  size_t clock_check_interval=DEFAULT_CLOCK_CHECK_INTERVAL;
+
+  /// Budget of n instructions.
+  static ProcessBudget Instructions(size_t n) {
+    ProcessBudget budget;
+    budget.max_instructions = n;
+    return budget;
+  }
+
+  /// Budget of n steps (like Process(n), but see ProcessStopReason::IDLE).
+  static ProcessBudget Steps(size_t n) {
+    ProcessBudget budget;
+    budget.max_steps = n;
+    return budget;
+  }
+
+  /// Budget that runs until the given wall-clock time.
+  static ProcessBudget Until(time_point_t time, size_t check_interval=DEFAULT_CLOCK_CHECK_INTERVAL) {
+    emp_assert(check_interval > 0, "Clock check interval must be > 0.");
+    ProcessBudget budget;
+    budget.deadline = time;
+    budget.clock_check_interval = check_interval;
+    return budget;
+  }
+
+  /// Budget that runs for the given wall-clock duration (starting now).
+  template<typename REP_T, typename PERIOD_T>
+  static ProcessBudget For(
+    const std::chrono::duration<REP_T, PERIOD_T>& duration,
+    size_t check_interval=DEFAULT_CLOCK_CHECK_INTERVAL
+  ) {
+    return Until(
+      wall_clock_t::now() + std::chrono::duration_cast<wall_clock_t::duration>(duration),
+      check_interval
+    );
+  }
+};
+
+/// Why BaseCPU::ProcessFor stopped.
+enum class ProcessStopReason {
+  IDLE,          ///< Hardware is idle (see BaseCPU::IsIdle); further steps would do nothing.
+  INSTRUCTIONS,  ///< Instruction budget used up.
+  STEPS,         ///< Step budget used up.
+  DEADLINE,      ///< Wall-clock deadline reached.
+  HALTED         ///< Hardware halted on a state cycle (see BaseCPU::SetHaltOnCycle).
+};
+
+/// What a call to BaseCPU::ProcessFor consumed (and why it stopped).
+struct ProcessResult {
+  ProcessStopReason reason=ProcessStopReason::IDLE;
+  size_t num_instructions=0;    ///< Number of instructions executed.
+  size_t num_steps=0;           ///< Number of steps finished (including a resumed step).
+  bool step_in_progress=false;  ///< Did processing stop partway through a step?
+  ProcessBudget::wall_clock_t::duration elapsed{0}; ///< Wall-clock time spent.
+};
+
+} // End sgp::cpu::sched namespace
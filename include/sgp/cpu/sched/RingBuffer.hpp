@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+#include "FixedVector.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Double-ended FIFO queue backed by a single circular buffer.
+/// Unlike std::deque, a RingBuffer never allocates or frees storage as elements are pushed and
+/// popped; storage only grows (geometrically) when pushing onto a full buffer or on Reserve.
+/// With CAPACITY > 0, storage is fixed (inline): the queue holds at most CAPACITY elements.
+template<typename T, size_t CAPACITY=0>
+class RingBuffer {
+public:
+  using value_t = T;
+
+  /// Const (random access) iterator over queue elements, front to back.
+  class const_iterator {
+    friend class RingBuffer;
+    const RingBuffer* ring;
+    size_t i;
+    const_iterator(const RingBuffer* r, size_t _i) : ring(r), i(_i) { ; }
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    reference operator*() const { return (*ring)[i]; }
+    pointer operator->() const { return &(*ring)[i]; }
+    const_iterator& operator++() { ++i; return *this; }
+    const_iterator operator++(int) { const_iterator tmp(*this); ++i; return tmp; }
+    const_iterator& operator--() { --i; return *this; }
+    const_iterator& operator+=(difference_type n) { i += n; return *this; }
+    const_iterator operator+(difference_type n) const { return const_iterator(ring, i + n); }
+    difference_type operator-(const const_iterator& o) const { return (difference_type)i - (difference_type)o.i; }
+    reference operator[](difference_type n) const { return (*ring)[i + n]; }
+    bool operator==(const const_iterator& o) const { return i == o.i && ring == o.ring; }
+    bool operator!=(const const_iterator& o) const { return !(*this == o); }
+    bool operator<(const const_iterator& o) const { return i < o.i; }
+  };
+
+protected:
+  Storage<T, CAPACITY> buffer;  ///< Circular storage (buffer.size() is the capacity).
+  size_t head=0;          ///< Position of the front element.
+  size_t count=0;         ///< Number of elements in the queue.
+
+  size_t Wrap(size_t pos) const { return (pos >= buffer.size()) ? pos - buffer.size() : pos; }
+
+public:
+  RingBuffer(size_t capacity=0) : buffer(CAPACITY ? CAPACITY : capacity) {
+    emp_assert(capacity <= buffer.size(), capacity, CAPACITY);
+  }
+
+  /// Get the number of elements this queue can hold without growing.
+  size_t GetCapacity() const { return buffer.size(); }
+
+  /// Ensure this queue can hold at least capacity elements without growing.
+  void Reserve(size_t capacity) {
+    if (capacity <= buffer.size()) return;
+    if constexpr (CAPACITY > 0) {
+      emp_assert(false, "RingBuffer capacity exceeded.", capacity, CAPACITY);
+    } else {
+      emp::vector<T> new_buffer(std::max(capacity, 2 * buffer.size()));
+      for (size_t i = 0; i < count; ++i) new_buffer[i] = std::move(buffer[Wrap(head + i)]);
+      buffer.swap(new_buffer);
+      head = 0;
+    }
+  }
+
+  size_t GetSize() const { return count; }
+  size_t size() const { return count; }
+  bool IsEmpty() const { return count == 0; }
+  bool empty() const { return count == 0; }
+
+  /// Get the i'th element from the front of the queue.
+  T& operator[](size_t i) {
+    emp_assert(i < count, i, count);
+    return buffer[Wrap(head + i)];
+  }
+
+  const T& operator[](size_t i) const {
+    emp_assert(i < count, i, count);
+    return buffer[Wrap(head + i)];
+  }
+
+  T& Front() { return (*this)[0]; }
+  const T& Front() const { return (*this)[0]; }
+  T& Back() { return (*this)[count - 1]; }
+  const T& Back() const { return (*this)[count - 1]; }
+
+  void PushBack(const T& val) {
+    if (count == buffer.size()) Reserve(count + 1);
+    buffer[Wrap(head + count)] = val;
+    ++count;
+  }
+
+  void PopFront() {
+    emp_assert(count, "Cannot pop from empty queue.");
+    head = Wrap(head + 1);
+    --count;
+  }
+
+  void PopBack() {
+    emp_assert(count, "Cannot pop from empty queue.");
+    --count;
+  }
+
+  /// Remove all elements (retains storage).
+  void Clear() { head = 0; count = 0; }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, count); }
+};
+
+} // End sgp::cpu::sched namespace
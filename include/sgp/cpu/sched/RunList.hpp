@@ -0,0 +1,146 @@
+#pragma once
+
+#include <iterator>
+#include <limits>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+#include "FixedVector.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Ordered list of integer ids drawn from [0:capacity) (an intrusive doubly linked list whose
+/// links are stored per id). Appending, removing any member, and finding a member's neighbors
+/// are all O(1); removal preserves the relative order of the remaining members.
+/// Once storage is sized (Resize), no operation allocates.
+/// With CAPACITY > 0, storage is fixed (inline) and capacity can never exceed CAPACITY.
+template<size_t CAPACITY=0>
+class BasicRunList {
+public:
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  /// Const (forward) iterator over member ids, front to back.
+  class const_iterator {
+    friend class BasicRunList;
+    const BasicRunList* list;
+    size_t id;
+    const_iterator(const BasicRunList* l, size_t _id) : list(l), id(_id) { ; }
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const size_t*;
+    using reference = const size_t&;
+
+    reference operator*() const { return id; }
+    const_iterator& operator++() { id = list->Next(id); return *this; }
+    const_iterator operator++(int) { const_iterator tmp(*this); ++(*this); return tmp; }
+    bool operator==(const const_iterator& o) const { return id == o.id && list == o.list; }
+    bool operator!=(const const_iterator& o) const { return !(*this == o); }
+  };
+
+protected:
+  struct Link {
+    size_t prev=npos;
+    size_t next=npos;
+    bool member=false;
+  };
+
+  Storage<Link, CAPACITY> links;  ///< For each possible id, its links.
+  size_t head=npos;         ///< First member (or npos).
+  size_t tail=npos;         ///< Last member (or npos).
+  size_t count=0;           ///< Number of members.
+  size_t version=0;         ///< Incremented every time the list changes.
+
+public:
+  BasicRunList(size_t capacity=0) : links(capacity) { ; }
+
+  /// Get the number of ids that can be tracked (valid ids are [0:capacity)).
+  size_t GetCapacity() const { return links.size(); }
+
+  /// Set the number of ids that can be tracked. Shrinking the capacity removes any members >=
+  /// the new capacity.
+  void Resize(size_t capacity) {
+    for (size_t id = capacity; id < links.size(); ++id) Remove(id);
+    links.resize(capacity);
+  }
+
+  size_t GetSize() const { return count; }
+  size_t size() const { return count; }
+  bool IsEmpty() const { return count == 0; }
+  bool empty() const { return count == 0; }
+
+  /// Get a counter that changes every time the list changes (e.g., to invalidate caches).
+  size_t GetVersion() const { return version; }
+
+  /// Is the given id a member of this list?
+  bool Has(size_t id) const { return id < links.size() && links[id].member; }
+
+  /// Get the first member (or npos if empty).
+  size_t Front() const { return head; }
+
+  /// Get the last member (or npos if empty).
+  size_t Back() const { return tail; }
+
+  /// Get the member after the given member (or npos if it is the last member).
+  size_t Next(size_t id) const {
+    emp_assert(Has(id), "ID not in list.", id);
+    return links[id].next;
+  }
+
+  /// Get the member before the given member (or npos if it is the first member).
+  size_t Prev(size_t id) const {
+    emp_assert(Has(id), "ID not in list.", id);
+    return links[id].prev;
+  }
+
+  /// Append id to the back of the list. Id must not already be a member.
+  void PushBack(size_t id) {
+    emp_assert(id < links.size(), "ID exceeds list capacity.", id, links.size());
+    emp_assert(!Has(id), "ID already in list.", id);
+    Link& link = links[id];
+    link.prev = tail;
+    link.next = npos;
+    link.member = true;
+    if (tail != npos) links[tail].next = id;
+    else head = id;
+    tail = id;
+    ++count;
+    ++version;
+  }
+
+  /// Remove id from the list. Returns false if id was not a member.
+  bool Remove(size_t id) {
+    if (!Has(id)) return false;
+    Link& link = links[id];
+    if (link.prev != npos) links[link.prev].next = link.next;
+    else head = link.next;
+    if (link.next != npos) links[link.next].prev = link.prev;
+    else tail = link.prev;
+    link = Link();
+    --count;
+    ++version;
+    return true;
+  }
+
+  /// Remove all members (O(size), not O(capacity)).
+  void Clear() {
+    for (size_t id = head; id != npos;) {
+      const size_t next = links[id].next;
+      links[id] = Link();
+      id = next;
+    }
+    head = npos;
+    tail = npos;
+    count = 0;
+    ++version;
+  }
+
+  const_iterator begin() const { return const_iterator(this, head); }
+  const_iterator end() const { return const_iterator(this, npos); }
+};
+
+using RunList = BasicRunList<>;
+
+} // End sgp::cpu::sched namespace
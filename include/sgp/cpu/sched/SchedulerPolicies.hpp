@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+
+namespace sgp::cpu::sched {
+
+// Thread scheduler policies (BaseCPU's SCHEDULER_T template parameter).
+//
+// A policy decides, at compile time, how BaseCPU admits spawned threads, activates pending
+// threads, evicts threads when there is no room, and how many steps each active thread executes
+// per SingleProcess. BaseCPU compiles out the scheduling paths a policy does not use (e.g., under
+// FIFOScheduler, threads are never indexed by priority, and the execution loop never checks for a
+// fair-share quantum).
+//
+// Each policy specifies:
+//   * CONFIGURABLE - Are scheduling decisions made at runtime using BaseCPU's scheduler settings
+//     (SetThreadPriorityUse, SetThreadQuantum, SetNumPriorityLevels, SetFairShareScheduling)?
+//     If false, the settings below are fixed, and those setters may only "set" the fixed value.
+//   * USE_PRIORITY - Are threads admitted, activated, and evicted by priority (higher-priority
+//     pending threads preempt lower-priority active threads), rather than by arrival order?
+//   * QUANTUM - Number of execution steps each active thread takes per SingleProcess.
+//   * NUM_PRIORITY_LEVELS - Number of integer priority levels (0 => priorities are compared as
+//     doubles; see BaseCPU::SetNumPriorityLevels).
+//   * MAX_ACTIVE_THREADS, THREAD_SPACE - Fixed active thread limit and thread capacity (0 =>
+//     capacities are set at runtime, and thread storage grows as needed). See FixedCapacity.
+
+/// Default policy: all scheduler settings are configurable at runtime (priority-preemptive with a
+/// quantum of 1 until configured otherwise).
+struct ConfigurableScheduler {
+  static constexpr bool CONFIGURABLE = true;
+  static constexpr bool USE_PRIORITY = true;
+  static constexpr size_t QUANTUM = 1;
+  static constexpr size_t NUM_PRIORITY_LEVELS = 0;
+  static constexpr size_t MAX_ACTIVE_THREADS = 0;
+  static constexpr size_t THREAD_SPACE = 0;
+};
+
+/// First-come-first-served: pending threads are activated in order of arrival (as long as there
+/// are free active slots), and active threads are never preempted. Thread priorities are ignored.
+/// Each active thread executes one step per SingleProcess.
+struct FIFOScheduler {
+  static constexpr bool CONFIGURABLE = false;
+  static constexpr bool USE_PRIORITY = false;
+  static constexpr size_t QUANTUM = 1;
+  static constexpr size_t NUM_PRIORITY_LEVELS = 0;
+  static constexpr size_t MAX_ACTIVE_THREADS = 0;
+  static constexpr size_t THREAD_SPACE = 0;
+};
+
+/// Priority-preemptive: when active slots run out, higher-priority pending threads replace
+/// lower-priority active threads, and, when thread space runs out, higher-priority spawns replace
+/// lower-priority pending threads. Each active thread executes one step per SingleProcess.
+/// With NUM_LEVELS > 0, priorities are compared as integer levels (see
+/// BaseCPU::SetNumPriorityLevels).
+template<size_t NUM_LEVELS=0>
+struct PriorityPreemptiveScheduler {
+  static constexpr bool CONFIGURABLE = false;
+  static constexpr bool USE_PRIORITY = true;
+  static constexpr size_t QUANTUM = 1;
+  static constexpr size_t NUM_PRIORITY_LEVELS = NUM_LEVELS;
+  static constexpr size_t MAX_ACTIVE_THREADS = 0;
+  static constexpr size_t THREAD_SPACE = 0;
+};
+
+/// Round-robin: admission and activation are first-come-first-served (as in FIFOScheduler), and
+/// each active thread executes up to QUANTUM_STEPS steps per SingleProcess, in activation order.
+template<size_t QUANTUM_STEPS>
+struct RoundRobinScheduler {
+  static_assert(QUANTUM_STEPS > 0, "Round-robin quantum must be > 0.");
+  static constexpr bool CONFIGURABLE = false;
+  static constexpr bool USE_PRIORITY = false;
+  static constexpr size_t QUANTUM = QUANTUM_STEPS;
+  static constexpr size_t NUM_PRIORITY_LEVELS = 0;
+  static constexpr size_t MAX_ACTIVE_THREADS = 0;
+  static constexpr size_t THREAD_SPACE = 0;
+};
+
+/// Fixed-capacity variant of the given policy: at most MAX_ACTIVE active threads and at most
+/// SPACE active + pending (+ blocked) threads. Capacities are compile-time constants, and all of
+/// BaseCPU's thread bookkeeping (including thread execution states) is stored inline, in
+/// fixed-size arrays, so it never allocates and needs no pointer chasing.
+template<size_t MAX_ACTIVE, size_t SPACE, typename POLICY_T=ConfigurableScheduler>
+struct FixedCapacity : POLICY_T {
+  static_assert(MAX_ACTIVE > 0, "Fixed active thread limit must be > 0.");
+  static_assert(MAX_ACTIVE <= SPACE, "Fixed active thread limit cannot exceed thread space.");
+  static constexpr size_t MAX_ACTIVE_THREADS = MAX_ACTIVE;
+  static constexpr size_t THREAD_SPACE = SPACE;
+};
+
+} // End sgp::cpu::sched namespace
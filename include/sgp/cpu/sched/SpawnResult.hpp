@@ -0,0 +1,64 @@
+#pragma once
+
+#include <limits>
+#include <optional>
+
+#include "emp/base/assert.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Outcome of a request to spawn a thread.
+enum class SpawnStatus {
+  SPAWNED,            ///< Thread spawned in an unused thread slot.
+  REPLACED_PENDING,   ///< Thread spawned by commandeering a lower-priority pending thread's slot.
+  REJECTED_NO_MATCH,  ///< No module matched the spawn request.
+  REJECTED_NO_SPACE,  ///< No thread space (and no lower-priority pending thread to replace), or
+                      ///< (admission control, without thread priority) no free active slot.
+  REJECTED_PRIORITY   ///< Rejected by admission control: the thread could not outrank its rivals
+                      ///< for an active slot.
+};
+
+/// Result of a request to spawn a thread: the spawned thread's id (if any) plus the outcome.
+/// Behaves like std::optional<size_t> (explicit bool conversion, has_value, value, operator*).
+class SpawnResult {
+public:
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+protected:
+  SpawnStatus status;
+  size_t thread_id;
+
+public:
+  SpawnResult(SpawnStatus _status, size_t _thread_id=npos)
+    : status(_status), thread_id(_thread_id)
+  {
+    emp_assert(has_value() == (thread_id != npos));
+  }
+
+  /// Get the outcome of the spawn request.
+  SpawnStatus GetStatus() const { return status; }
+
+  /// Was a thread spawned?
+  bool has_value() const {
+    return status == SpawnStatus::SPAWNED || status == SpawnStatus::REPLACED_PENDING;
+  }
+
+  explicit operator bool() const { return has_value(); }
+
+  /// Was the request rejected?
+  bool IsRejected() const { return !has_value(); }
+
+  /// Get the id of the spawned thread. Requires that a thread was spawned.
+  size_t value() const {
+    emp_assert(has_value(), "No thread was spawned.");
+    return thread_id;
+  }
+
+  size_t operator*() const { return value(); }
+
+  operator std::optional<size_t>() const {
+    return has_value() ? std::optional<size_t>{thread_id} : std::nullopt;
+  }
+};
+
+} // End sgp::cpu::sched namespace
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+
+#include "emp/base/assert.hpp"
+
+#include "FixedVector.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Which of the hardware's thread tracking structures a thread id belongs to.
+enum class Membership : uint8_t {
+  NONE,     ///< Not tracked (e.g., claimed by a spawn, but not yet pending).
+  UNUSED,   ///< In the pool of unused thread ids.
+  PENDING,  ///< In the pending queue.
+  ACTIVE,   ///< In the active set and the execution order.
+  PARKED,   ///< Blocked and parked (only in the wait lists).
+  WOKEN     ///< Woken, but still parked until there is an active slot for it (in the woken queue).
+};
+
+/// Debug-only record of each thread id's membership (see Membership), kept up to date
+/// incrementally as threads move between tracking structures. Lets BaseCPU check, in O(1), that
+/// a thread is where it is expected to be (rather than scanning the unused pool or the pending
+/// queue).
+///
+/// With NDEBUG defined, nothing is stored, updates are no-ops, and every Check passes.
+/// With CAPACITY > 0, storage is fixed (inline).
+template<size_t CAPACITY=0>
+class ThreadMembership {
+public:
+#ifdef NDEBUG
+  static constexpr bool ENABLED = false;
+#else
+  static constexpr bool ENABLED = true;
+#endif
+
+protected:
+#ifndef NDEBUG
+  Storage<Membership, CAPACITY> tags; ///< Membership of each thread id.
+#endif
+
+public:
+  ThreadMembership(size_t n=0, Membership m=Membership::NONE) { Reset(n, m); }
+
+  /// Track n thread ids, all with the given membership.
+  void Reset([[maybe_unused]] size_t n, [[maybe_unused]] Membership m=Membership::NONE) {
+#ifndef NDEBUG
+    tags.clear();
+    tags.resize(n, m);
+#endif
+  }
+
+  /// Set the number of tracked thread ids (new ids have no membership).
+  void Resize([[maybe_unused]] size_t n) {
+#ifndef NDEBUG
+    tags.resize(n, Membership::NONE);
+#endif
+  }
+
+  /// Record the given thread id's membership.
+  void Set([[maybe_unused]] size_t id, [[maybe_unused]] Membership m) {
+#ifndef NDEBUG
+    emp_assert(id < tags.size(), id, tags.size());
+    tags[id] = m;
+#endif
+  }
+
+  /// Does the given thread id have membership m? (Always true if tracking is disabled.)
+  bool Check([[maybe_unused]] size_t id, [[maybe_unused]] Membership m) const {
+#ifndef NDEBUG
+    return id < tags.size() && tags[id] == m;
+#else
+    return true;
+#endif
+  }
+};
+
+} // End sgp::cpu::sched namespace
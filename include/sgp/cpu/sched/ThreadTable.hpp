@@ -0,0 +1,269 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+#include "ChunkedArray.hpp"
+#include "FixedVector.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Thread run states.
+enum class ThreadState : uint8_t { RUNNING, DEAD, PENDING, BLOCKED };
+
+/// Does T have a Recycle() member function?
+template<typename T, typename=void>
+struct HasRecycle : std::false_type { };
+
+template<typename T>
+struct HasRecycle<T, std::void_t<decltype(std::declval<T&>().Recycle())>> : std::true_type { };
+
+/// Storage for all of a hardware unit's threads, indexed by thread id, in struct-of-arrays layout:
+/// each piece of scheduler metadata (run state, priority, etc.) is kept in its own contiguous
+/// array, and execution states (typically large) are kept in a separate array. Scheduling passes
+/// that only look at run states or priorities never touch execution states.
+///
+/// Execution states are stored in fixed-size chunks (see ChunkedArray), so they never move when
+/// the table grows: a reference to a thread's execution state remains valid across spawns (e.g.,
+/// while an instruction that spawns threads is executing), and growth never copies execution
+/// states.
+///
+/// Optionally, execution states can be recycled rather than reset when threads are reset (see
+/// SetExecStateRecycling); this requires EXEC_STATE_T::Recycle().
+///
+/// Individual threads are accessed through Thread handles (see operator[]), which are cheap to
+/// copy and remain valid (as long as the thread id is valid) when the table is resized.
+///
+/// With CAPACITY > 0, the table holds at most CAPACITY threads, and all storage (including
+/// execution states) is fixed and inline.
+template<typename EXEC_STATE_T, size_t CAPACITY=0>
+class ThreadTable {
+public:
+  using exec_state_t = EXEC_STATE_T;
+  using this_t = ThreadTable<EXEC_STATE_T, CAPACITY>;
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+  static constexpr bool CAN_RECYCLE = HasRecycle<exec_state_t>::value;
+
+  /// Handle to a single thread in a thread table.
+  class Thread {
+  public:
+    using ThreadState = sched::ThreadState;
+
+  protected:
+    this_t* table;
+    size_t id;
+
+  public:
+    Thread(this_t& _table, size_t _id) : table(&_table), id(_id) { ; }
+
+    /// Get this thread's id.
+    size_t GetID() const { return id; }
+
+    /// Reset thread to default state (priority = 1, DEAD). Calls EXEC_STATE_T::Reset() (or
+    /// EXEC_STATE_T::Recycle(), if execution state recycling is on).
+    void Reset() { table->Reset(id); }
+
+    /// Is this thread waiting to be initialized (i.e., spawned, but InitThread not yet called)?
+    bool IsInitDeferred() const { return table->IsInitDeferred(id); }
+
+    exec_state_t& GetExecState() { return table->GetExecState(id); }
+    const exec_state_t& GetExecState() const { return table->GetExecState(id); }
+
+    /// Get this thread's run state.
+    ThreadState GetRunState() const { return table->GetRunState(id); }
+
+    /// Set thread state to DEAD.
+    void SetDead() { table->SetRunState(id, ThreadState::DEAD); }
+
+    /// Is this thread dead?
+    bool IsDead() const { return GetRunState() == ThreadState::DEAD; }
+
+    /// Set thread state to PENDING.
+    void SetPending() { table->SetRunState(id, ThreadState::PENDING); }
+
+    /// Is this thread PENDING?
+    bool IsPending() const { return GetRunState() == ThreadState::PENDING; }
+
+    /// Set thread state to RUNNING.
+    void SetRunning() { table->SetRunState(id, ThreadState::RUNNING); }
+
+    /// Is this thread RUNNING?
+    bool IsRunning() const { return GetRunState() == ThreadState::RUNNING; }
+
+    /// Set thread state to BLOCKED.
+    /// NOTE: to block a thread, use BaseCPU::BlockThread (which registers the thread's wait key).
+    void SetBlocked() { table->SetRunState(id, ThreadState::BLOCKED); }
+
+    /// Is this thread BLOCKED (waiting to be woken)?
+    bool IsBlocked() const { return GetRunState() == ThreadState::BLOCKED; }
+
+    /// Retrieve this thread's priority level.
+    double GetPriority() const { return table->GetPriority(id); }
+
+    // NOTE: there is deliberately no SetPriority here; the hardware indexes PENDING and RUNNING
+    //       threads by priority, so priorities must be changed via BaseCPU::SetThreadPriority.
+
+    /// Get the hardware step at which this thread was spawned.
+    size_t GetSpawnStep() const { return table->GetSpawnStep(id); }
+
+    /// Get the number of execution steps this thread has taken since it was spawned.
+    size_t GetNumExecSteps() const { return table->GetNumExecSteps(id); }
+
+    /// Get the hardware step at which this thread took its first execution step (npos if it has
+    /// not executed yet).
+    size_t GetFirstExecStep() const { return table->GetFirstExecStep(id); }
+
+    /// Get this thread's virtual runtime (execution steps, weighted by priority; only tracked in
+    /// fair-share scheduling mode).
+    double GetVirtualRuntime() const { return table->GetVirtualRuntime(id); }
+  };
+
+protected:
+  using exec_states_t = std::conditional_t<
+    CAPACITY == 0,
+    ChunkedArray<exec_state_t>,
+    FixedVector<exec_state_t, CAPACITY>
+  >;
+
+  Storage<ThreadState, CAPACITY> run_states;  ///< Run state of each thread.
+  Storage<double, CAPACITY> priorities;       ///< Priority of each thread.
+  Storage<size_t, CAPACITY> init_modules;     ///< Module to initialize each thread with (npos if initialization is not deferred).
+  Storage<size_t, CAPACITY> spawn_steps;      ///< Hardware step at which each thread was spawned.
+  Storage<size_t, CAPACITY> exec_steps;       ///< Number of execution steps each thread has taken.
+  Storage<size_t, CAPACITY> first_exec_steps; ///< Hardware step of each thread's first execution step (npos if none).
+  Storage<double, CAPACITY> vruntimes;        ///< Virtual runtime of each thread.
+  Storage<double, CAPACITY> credits;          ///< Execution step credit of each thread (for fair-share scheduling).
+  exec_states_t exec_states;                  ///< Execution state of each thread (stable addresses).
+  bool recycle_exec_states=false;         ///< Should resetting a thread recycle its execution state?
+
+public:
+  ThreadTable(size_t n=0)
+    : run_states(n, ThreadState::DEAD),
+      priorities(n, 1.0),
+      init_modules(n, npos),
+      spawn_steps(n, 0),
+      exec_steps(n, 0),
+      first_exec_steps(n, npos),
+      vruntimes(n, 0.0),
+      credits(n, 0.0),
+      exec_states(n)
+  { ; }
+
+  /// Get the number of threads in the table.
+  size_t size() const { return run_states.size(); }
+  size_t GetSize() const { return run_states.size(); }
+
+  /// Set the number of threads in the table. New threads are DEAD (with priority 1).
+  void Resize(size_t n) {
+    run_states.resize(n, ThreadState::DEAD);
+    priorities.resize(n, 1.0);
+    init_modules.resize(n, npos);
+    spawn_steps.resize(n, 0);
+    exec_steps.resize(n, 0);
+    first_exec_steps.resize(n, npos);
+    vruntimes.resize(n, 0.0);
+    credits.resize(n, 0.0);
+    if constexpr (CAPACITY > 0) exec_states.resize(n);
+    else exec_states.Resize(n);
+  }
+
+  /// Get a handle to the given thread.
+  Thread operator[](size_t id) {
+    emp_assert(id < size(), id, size());
+    return Thread(*this, id);
+  }
+
+  /// Get a (const) handle to the given thread.
+  const Thread operator[](size_t id) const {
+    emp_assert(id < size(), id, size());
+    return Thread(const_cast<this_t&>(*this), id);
+  }
+
+  /// Is execution state recycling on?
+  bool IsExecStateRecyclingUsed() const { return recycle_exec_states; }
+
+  /// Should resetting a thread recycle its execution state (EXEC_STATE_T::Recycle) rather than
+  /// reset it (EXEC_STATE_T::Reset)? Recycling should leave an execution state logically
+  /// equivalent to a reset one, but keep its allocated storage for reuse.
+  void SetExecStateRecycling(bool recycle=true) {
+    emp_assert(!recycle || CAN_RECYCLE, "Execution state type does not support recycling.");
+    recycle_exec_states = recycle && CAN_RECYCLE;
+  }
+
+  /// Reset the given thread to default state (priority = 1, DEAD). Calls EXEC_STATE_T::Reset() (or
+  /// EXEC_STATE_T::Recycle(), if execution state recycling is on).
+  void Reset(size_t id) {
+    emp_assert(id < size(), id, size());
+    ResetExecState(id);
+    run_states[id] = ThreadState::DEAD;
+    priorities[id] = 1.0;
+    init_modules[id] = npos;
+    spawn_steps[id] = 0;
+    exec_steps[id] = 0;
+    first_exec_steps[id] = npos;
+    vruntimes[id] = 0.0;
+    credits[id] = 0.0;
+  }
+
+  ThreadState GetRunState(size_t id) const { return run_states[id]; }
+  void SetRunState(size_t id, ThreadState state) { run_states[id] = state; }
+
+  double GetPriority(size_t id) const { return priorities[id]; }
+  /// NOTE: does not update the hardware's thread scheduling structures (see
+  ///       BaseCPU::SetThreadPriority).
+  void SetPriority(size_t id, double priority) { priorities[id] = priority; }
+
+  /// Defer initialization of the given thread (with the given module) until it is activated.
+  void DeferInit(size_t id, size_t module_id) {
+    emp_assert(module_id != npos);
+    init_modules[id] = module_id;
+  }
+  bool IsInitDeferred(size_t id) const { return init_modules[id] != npos; }
+
+  /// Get the module that the given thread's (deferred) initialization uses.
+  size_t GetInitModule(size_t id) const { return init_modules[id]; }
+
+  /// Mark the given thread's deferred initialization as done.
+  void ClearInitDeferred(size_t id) { init_modules[id] = npos; }
+
+  size_t GetSpawnStep(size_t id) const { return spawn_steps[id]; }
+  void SetSpawnStep(size_t id, size_t step) { spawn_steps[id] = step; }
+
+  size_t GetNumExecSteps(size_t id) const { return exec_steps[id]; }
+  void AddExecSteps(size_t id, size_t num_steps) { exec_steps[id] += num_steps; }
+
+  size_t GetFirstExecStep(size_t id) const { return first_exec_steps[id]; }
+  void SetFirstExecStep(size_t id, size_t step) { first_exec_steps[id] = step; }
+
+  double GetVirtualRuntime(size_t id) const { return vruntimes[id]; }
+  void AddVirtualRuntime(size_t id, double runtime) { vruntimes[id] += runtime; }
+
+  double GetCredit(size_t id) const { return credits[id]; }
+  void SetCredit(size_t id, double credit) { credits[id] = credit; }
+
+  /// Reset (or recycle, if recycling is on) the given thread's execution state.
+  void ResetExecState(size_t id) {
+    if constexpr (CAN_RECYCLE) {
+      if (recycle_exec_states) {
+        exec_states[id].Recycle();
+        return;
+      }
+    }
+    exec_states[id].Reset();
+  }
+
+  exec_state_t& GetExecState(size_t id) { return exec_states[id]; }
+  const exec_state_t& GetExecState(size_t id) const { return exec_states[id]; }
+
+  /// Reset all threads.
+  void ResetAll() {
+    for (size_t id = 0; id < size(); ++id) Reset(id);
+  }
+};
+
+} // End sgp::cpu::sched namespace
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <limits>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Hierarchical timing wheel: a queue of items, each scheduled to expire at an integer time step.
+///
+/// Level l of the wheel has SLOTS slots that each span SLOTS^l time steps. An item lives at the
+/// lowest level that can distinguish its expiry time from the current time; when the current
+/// time crosses a slot boundary at level l, that slot's items are 'cascaded' down to lower levels.
+/// Items too far in the future for the top level wait in an overflow list that is only revisited
+/// every SLOTS^NUM_LEVELS steps.
+/// - Insert is O(1).
+/// - Advance is O(1) amortized (plus the cost of expiring items); items never cascade more than
+///   NUM_LEVELS times, and far-future items cost nothing per step.
+/// - Items that expire at the same time step are expired in insertion order.
+/// Item storage is pooled, so once the wheel reaches its working size, no operation allocates.
+/// Wheel slots are allocated on the first Insert (an unused wheel allocates nothing).
+template<typename T>
+class TimingWheel {
+public:
+  using value_t = T;
+  static constexpr size_t LEVEL_BITS = 6;
+  static constexpr size_t SLOTS = size_t(1) << LEVEL_BITS;   ///< Slots per level.
+  static constexpr size_t NUM_LEVELS = 4;
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+protected:
+  static constexpr size_t SLOT_MASK = SLOTS - 1;
+  static constexpr size_t WHEEL_BITS = LEVEL_BITS * NUM_LEVELS;  ///< Time bits covered by the wheel.
+
+  struct Node {
+    value_t value;
+    size_t time=0;      ///< Expiry time.
+    size_t next=npos;   ///< Next node in the same slot (or in the free list).
+  };
+
+  struct Slot {
+    size_t head=npos;
+    size_t tail=npos;
+  };
+
+  emp::vector<Node> nodes;          ///< Node pool (free nodes are linked through 'next').
+  size_t free_head=npos;            ///< First free node in the pool.
+  emp::vector<Slot> slots;          ///< NUM_LEVELS x SLOTS wheel slots.
+  Slot overflow;                    ///< Items beyond the range of the wheel.
+  size_t now=0;                     ///< Current time.
+  size_t count=0;                   ///< Number of scheduled items.
+
+  Slot& GetSlot(size_t level, size_t index) { return slots[level * SLOTS + index]; }
+
+  /// Append node to the slot appropriate for its expiry time, relative to the current time.
+  void Place(size_t node_id) {
+    Node& node = nodes[node_id];
+    node.next = npos;
+    const size_t diff = node.time ^ now;
+    Slot* slot = &overflow;
+    for (size_t level = 0; level < NUM_LEVELS; ++level) {
+      if (diff < (size_t(1) << (LEVEL_BITS * (level + 1)))) {
+        slot = &GetSlot(level, (node.time >> (LEVEL_BITS * level)) & SLOT_MASK);
+        break;
+      }
+    }
+    if (slot->tail != npos) nodes[slot->tail].next = node_id;
+    else slot->head = node_id;
+    slot->tail = node_id;
+  }
+
+  /// Detach all nodes from slot, and re-place them relative to the current time (in order).
+  void Cascade(Slot& slot) {
+    size_t node_id = slot.head;
+    slot = Slot();
+    while (node_id != npos) {
+      const size_t next = nodes[node_id].next;
+      Place(node_id);
+      node_id = next;
+    }
+  }
+
+  void FreeNode(size_t node_id) {
+    nodes[node_id].next = free_head;
+    free_head = node_id;
+  }
+
+public:
+  TimingWheel() : nodes(), slots(), overflow() { ; }
+
+  /// Get the current time step.
+  size_t GetTime() const { return now; }
+
+  /// Get the number of scheduled items.
+  size_t GetSize() const { return count; }
+  size_t size() const { return count; }
+  bool IsEmpty() const { return count == 0; }
+  bool empty() const { return count == 0; }
+
+  /// Schedule value to expire at the given time step. Times in the past are treated as the
+  /// current time step (i.e., the value expires at the next Advance).
+  void Insert(size_t time, const value_t& value) {
+    if (slots.empty()) slots.resize(NUM_LEVELS * SLOTS); // Allocate wheel on first use.
+    size_t node_id;
+    if (free_head != npos) {
+      node_id = free_head;
+      free_head = nodes[node_id].next;
+    } else {
+      node_id = nodes.size();
+      nodes.emplace_back();
+    }
+    nodes[node_id].value = value;
+    nodes[node_id].time = (time < now) ? now : time;
+    Place(node_id);
+    ++count;
+  }
+
+  /// Expire all values scheduled for the current time step (calling on_expire(value_t&&) for
+  /// each, in insertion order) and advance to the next time step.
+  /// It is safe for on_expire to Insert; values inserted for the (former) current time step
+  /// expire at the next Advance.
+  template<typename FUN>
+  void Advance(FUN&& on_expire) {
+    if (!count) { ++now; return; }
+    // Detach the items that are due now.
+    Slot& due_slot = GetSlot(0, now & SLOT_MASK);
+    size_t node_id = due_slot.head;
+    due_slot = Slot();
+    // Advance time, cascading any higher-level slots whose span we just entered (highest level
+    // first, so that cascaded items are never stranded in an already-cascaded slot).
+    ++now;
+    if (!(now & SLOT_MASK)) {
+      if (!(now & ((size_t(1) << WHEEL_BITS) - 1))) Cascade(overflow);
+      size_t top = 1;
+      while (top < NUM_LEVELS - 1 && !((now >> (LEVEL_BITS * top)) & SLOT_MASK)) ++top;
+      for (size_t level = top; level > 0; --level) {
+        Cascade(GetSlot(level, (now >> (LEVEL_BITS * level)) & SLOT_MASK));
+      }
+    }
+    // Expire due items.
+    while (node_id != npos) {
+      emp_assert(nodes[node_id].time == now - 1, nodes[node_id].time, now);
+      const size_t next = nodes[node_id].next;
+      --count;
+      value_t value(std::move(nodes[node_id].value));
+      nodes[node_id].value = value_t();
+      FreeNode(node_id);
+      on_expire(std::move(value));
+      node_id = next;
+    }
+  }
+
+  /// Remove all scheduled values (the current time is unchanged).
+  void Clear() {
+    for (Slot& slot : slots) slot = Slot();
+    overflow = Slot();
+    nodes.clear();
+    free_head = npos;
+    count = 0;
+  }
+
+  /// Remove all scheduled values and set the current time back to 0.
+  void Reset() {
+    Clear();
+    now = 0;
+  }
+};
+
+} // End sgp::cpu::sched namespace
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <limits>
+#include <unordered_map>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+#include "FixedVector.hpp"
+
+namespace sgp::cpu::sched {
+
+/// FIFO wait lists over integer ids drawn from [0:capacity), keyed on arbitrary (size_t) wait keys.
+/// Each id waits on at most one key at a time.
+///
+/// Lists are intrusive (linked through per-id storage), so adding an id, removing an id, and
+/// finding the first id waiting on a key are all O(1); nothing ever scans the waiting ids.
+/// Once storage is sized (Resize), no operation allocates, except for the first Insert on a
+/// previously unseen wait key (emptied lists are retained for reuse).
+/// With CAPACITY > 0, per-id storage is fixed (inline) and capacity can never exceed CAPACITY.
+template<size_t CAPACITY=0>
+class BasicWaitLists {
+public:
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+protected:
+  struct Link {
+    size_t key=npos;      ///< Wait key (only meaningful for waiting ids).
+    size_t prev=npos;     ///< Previous id waiting on the same key (or npos).
+    size_t next=npos;     ///< Next id waiting on the same key (or npos).
+    bool waiting=false;   ///< Is this id in a wait list?
+  };
+
+  struct List {
+    size_t head=npos;
+    size_t tail=npos;
+  };
+
+  Storage<Link, CAPACITY> links;          ///< For each possible id, its wait list links.
+  std::unordered_map<size_t, List> lists; ///< Wait key => wait list.
+  size_t count=0;                         ///< Total number of waiting ids.
+
+public:
+  BasicWaitLists(size_t capacity=0) : links(capacity), lists() { ; }
+
+  /// Get the number of ids that can be tracked (valid ids are [0:capacity)).
+  size_t GetCapacity() const { return links.size(); }
+
+  /// Set the number of ids that can be tracked. Shrinking the capacity removes any waiting
+  /// ids >= the new capacity.
+  void Resize(size_t capacity) {
+    for (size_t id = capacity; id < links.size(); ++id) Remove(id);
+    links.resize(capacity);
+  }
+
+  /// Get the total number of waiting ids (across all keys).
+  size_t GetSize() const { return count; }
+  size_t size() const { return count; }
+  bool IsEmpty() const { return count == 0; }
+  bool empty() const { return count == 0; }
+
+  /// Is the given id waiting (on any key)?
+  bool Has(size_t id) const { return id < links.size() && links[id].waiting; }
+
+  /// Get the key that the given (waiting) id is waiting on.
+  size_t GetKey(size_t id) const {
+    emp_assert(Has(id), "ID is not waiting.", id);
+    return links[id].key;
+  }
+
+  /// Get the id that has been waiting on the given key the longest (or npos if none).
+  size_t Front(size_t key) const {
+    auto it = lists.find(key);
+    return (it == lists.end()) ? npos : it->second.head;
+  }
+
+  /// Get the id waiting on the same key right after the given (waiting) id (or npos if none).
+  size_t Next(size_t id) const {
+    emp_assert(Has(id), "ID is not waiting.", id);
+    return links[id].next;
+  }
+
+  /// Is any id waiting on the given key?
+  bool HasWaiting(size_t key) const { return Front(key) != npos; }
+
+  /// Add id to the back of the wait list for key. Id must not already be waiting.
+  void Insert(size_t id, size_t key) {
+    emp_assert(id < links.size(), "ID exceeds wait list capacity.", id, links.size());
+    emp_assert(!Has(id), "ID already waiting.", id);
+    List& list = lists[key];
+    Link& link = links[id];
+    link.key = key;
+    link.prev = list.tail;
+    link.next = npos;
+    link.waiting = true;
+    if (list.tail != npos) links[list.tail].next = id;
+    else list.head = id;
+    list.tail = id;
+    ++count;
+  }
+
+  /// Remove id from its wait list. Returns false if id was not waiting.
+  bool Remove(size_t id) {
+    if (!Has(id)) return false;
+    Link& link = links[id];
+    List& list = lists[link.key];
+    if (link.prev != npos) links[link.prev].next = link.next;
+    else list.head = link.next;
+    if (link.next != npos) links[link.next].prev = link.prev;
+    else list.tail = link.prev;
+    link = Link();
+    --count;
+    return true;
+  }
+
+  /// Remove all waiting ids (O(size + number of keys seen), not O(capacity)).
+  void Clear() {
+    for (auto& entry : lists) {
+      List& list = entry.second;
+      for (size_t id = list.head; id != npos;) {
+        const size_t next = links[id].next;
+        links[id] = Link();
+        id = next;
+      }
+      list = List();
+    }
+    count = 0;
+  }
+};
+
+using WaitLists = BasicWaitLists<>;
+
+} // End sgp::cpu::sched namespace
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+namespace sgp::cpu::sched {
+
+/// Fixed pool of OS worker threads for running batches of independent tasks (see Run).
+/// The thread that calls Run participates in the batch, so a pool of N threads starts N-1
+/// workers. Workers sleep between batches. Running a batch does not allocate.
+/// Run may be called from several threads; batches run one at a time.
+class WorkerPool {
+protected:
+  using task_fun_t = void (*)(void*, size_t);
+
+  emp::vector<std::thread> workers;   ///< Worker threads (not including the caller of Run).
+  std::mutex run_mutex;               ///< Held for the duration of a batch.
+  std::mutex mutex;                   ///< Guards batch hand-off state (below).
+  std::condition_variable start_cv;   ///< Signals workers that a batch (or shutdown) is ready.
+  std::condition_variable done_cv;    ///< Signals Run that all workers have finished the batch.
+  task_fun_t task_fun=nullptr;        ///< Runs task i of the current batch (type-erased).
+  void* task_obj=nullptr;             ///< Callable for the current batch.
+  size_t num_tasks=0;                 ///< Number of tasks in the current batch.
+  std::atomic<size_t> next_task{0};   ///< Next unclaimed task in the current batch.
+  size_t generation=0;                ///< Batch counter (workers wait for it to change).
+  size_t num_busy=0;                  ///< Number of workers still working on the current batch.
+  bool stopping=false;                ///< Should workers exit?
+
+  /// Claim and run tasks from the current batch until there are none left.
+  void RunTasks() {
+    for (size_t i = next_task++; i < num_tasks; i = next_task++) task_fun(task_obj, i);
+  }
+
+  void WorkerLoop() {
+    size_t seen_generation = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        start_cv.wait(lock, [this, seen_generation]() {
+          return stopping || generation != seen_generation;
+        });
+        if (stopping) return;
+        seen_generation = generation;
+      }
+      RunTasks();
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--num_busy == 0) done_cv.notify_one();
+    }
+  }
+
+public:
+  /// Create a pool of num_threads threads (including the thread that calls Run).
+  WorkerPool(size_t num_threads) {
+    emp_assert(num_threads > 0, "Worker pool needs at least one thread.");
+    workers.reserve(num_threads - 1);
+    for (size_t i = 1; i < num_threads; ++i) workers.emplace_back([this]() { WorkerLoop(); });
+  }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    start_cv.notify_all();
+    for (std::thread& worker : workers) worker.join();
+  }
+
+  /// Get the number of threads that run batches (including the caller of Run).
+  size_t GetNumThreads() const { return workers.size() + 1; }
+
+  /// Call fun(i) for each i in [0:n), spread across the pool's threads, and wait for all calls
+  /// to finish. Calls may run in any order, and concurrently.
+  template<typename FUN_T>
+  void Run(size_t n, FUN_T& fun) {
+    if (workers.empty() || n < 2) {
+      for (size_t i = 0; i < n; ++i) fun(i);
+      return;
+    }
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      task_fun = [](void* obj, size_t i) { (*static_cast<FUN_T*>(obj))(i); };
+      task_obj = &fun;
+      num_tasks = n;
+      next_task = 0;
+      num_busy = workers.size();
+      ++generation;
+    }
+    start_cv.notify_all();
+    RunTasks();
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cv.wait(lock, [this]() { return num_busy == 0; });
+    task_fun = nullptr;
+    task_obj = nullptr;
+  }
+};
+
+} // End sgp::cpu::sched namespace
@@ -29,7 +29,8 @@ namespace sgp::inst {
 enum class InstProperty {
   MODULE,
   BLOCK_CLOSE,
-  BLOCK_DEF
+  BLOCK_DEF,
+  THREAD_LOCAL  ///< Only reads/writes the executing thread's state (safe to execute in parallel).
 };
 
 template<typename HARDWARE_T, typename INSTRUCTION_T>
@@ -17,6 +17,7 @@ public:
 
 protected:
   using base_t::default_instructions;
+  using base_t::AddAllInstructions;
 
   std::map<
     std::string,
@@ -36,6 +37,14 @@ protected:
     { "SenseOwnRegulator", BuildInstructionDef<Inst_SenseOwnRegulator<hw_t>, inst_def_t>() }
   };
 
+  std::map<
+    std::string,
+    inst_def_t
+  > scheduling_instructions = {
+    { "WaitForEvent", BuildInstructionDef<Inst_WaitForEvent<hw_t>, inst_def_t>() },
+    { "WaitForTag", BuildInstructionDef<Inst_WaitForTag<hw_t>, inst_def_t>() }
+  };
+
 public:
 
   InstructionAdder() {
@@ -79,6 +88,17 @@ public:
     };
   }
 
+  void AddAllSchedulingInstructions(
+    inst_lib_t& inst_lib,
+    const std::unordered_set<std::string>& except = {}
+  ) {
+    AddAllInstructions(
+      scheduling_instructions,
+      inst_lib,
+      except
+    );
+  }
+
   void AddAllRegulationInstructions(
     inst_lib_t& inst_lib,
     const emp::vector<std::string>& except = {}
@@ -210,11 +210,9 @@ struct Inst_Routine : BaseInstructionSpec<Inst_Routine<HARDWARE_T>> {
 
   static void run(hw_t& hw, const inst_t& inst) {
     using flow_type_t = cpu::linprg::FlowType;
-    emp::vector<size_t> matches(
-      hw.FindModuleMatch(inst.GetTag(0))
-    );
-    if (matches.size()) {
-      const size_t module_id = matches[0];
+    const auto match = hw.FindBestModuleMatch(inst.GetTag(0));
+    if (match) {
+      const size_t module_id = *match;
       emp_assert(module_id < hw.GetProgram().GetSize());
       const auto& target_module = hw.GetProgram()[module_id];
       // Flow: type mp ip begin end
@@ -260,4 +258,12 @@ using Inst_Fork = lpbm::Inst_Fork<HARDWARE_T>;
 template<typename HARDWARE_T>
 using Inst_Terminate = lpbm::Inst_Terminate<HARDWARE_T>;
 
+// WaitForEvent
+template<typename HARDWARE_T>
+using Inst_WaitForEvent = lpbm::Inst_WaitForEvent<HARDWARE_T>;
+
+// WaitForTag
+template<typename HARDWARE_T>
+using Inst_WaitForTag = lpbm::Inst_WaitForTag<HARDWARE_T>;
+
 }
\ No newline at end of file
@@ -39,7 +39,7 @@ struct Inst_Nop : BaseInstructionSpec<Inst_Nop<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) { ; }
@@ -61,7 +61,7 @@ struct Inst_Inc : BaseInstructionSpec<Inst_Inc<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -87,7 +87,7 @@ struct Inst_Dec : BaseInstructionSpec<Inst_Dec<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -113,7 +113,7 @@ struct Inst_Not : BaseInstructionSpec<Inst_Not<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -142,7 +142,7 @@ struct Inst_Add : BaseInstructionSpec<Inst_Add<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -171,7 +171,7 @@ struct Inst_Sub : BaseInstructionSpec<Inst_Sub<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -200,7 +200,7 @@ struct Inst_Mult : BaseInstructionSpec<Inst_Mult<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -229,7 +229,7 @@ struct Inst_Div : BaseInstructionSpec<Inst_Div<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -258,7 +258,7 @@ struct Inst_Mod : BaseInstructionSpec<Inst_Mod<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -290,7 +290,7 @@ struct Inst_TestEqu : BaseInstructionSpec<Inst_TestEqu<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -319,7 +319,7 @@ struct Inst_TestNEqu : BaseInstructionSpec<Inst_TestNEqu<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -348,7 +348,7 @@ struct Inst_TestLess : BaseInstructionSpec<Inst_TestLess<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -377,7 +377,7 @@ struct Inst_TestLessEqu : BaseInstructionSpec<Inst_TestLessEqu<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -406,7 +406,7 @@ struct Inst_TestGreater : BaseInstructionSpec<Inst_TestGreater<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -435,7 +435,7 @@ struct Inst_TestGreaterEqu : BaseInstructionSpec<Inst_TestGreaterEqu<HARDWARE_T>
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -474,7 +474,7 @@ struct Inst_Terminal : BaseInstructionSpec<
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
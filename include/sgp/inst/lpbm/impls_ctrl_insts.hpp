@@ -34,7 +34,7 @@ struct Inst_ModuleDef : BaseInstructionSpec<Inst_ModuleDef<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{ inst_prop_t::MODULE };
+    return std::unordered_set<inst_prop_t>{inst_prop_t::MODULE, inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) { ; }
@@ -56,7 +56,7 @@ struct Inst_If : BaseInstructionSpec<Inst_If<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{inst_prop_t::BLOCK_DEF};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::BLOCK_DEF, inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -119,7 +119,7 @@ struct Inst_While : BaseInstructionSpec<Inst_While<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{inst_prop_t::BLOCK_DEF};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::BLOCK_DEF, inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -181,7 +181,7 @@ struct Inst_Countdown : BaseInstructionSpec<Inst_Countdown<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{inst_prop_t::BLOCK_DEF};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::BLOCK_DEF, inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -244,7 +244,7 @@ struct Inst_Break : BaseInstructionSpec<Inst_Break<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -310,7 +310,7 @@ struct Inst_Close : BaseInstructionSpec<Inst_Close<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{inst_prop_t::BLOCK_CLOSE};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::BLOCK_CLOSE, inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -376,11 +376,9 @@ struct Inst_Routine : BaseInstructionSpec<Inst_Routine<HARDWARE_T>> {
 
   static void run(hw_t& hw, const inst_t& inst) {
     using flow_type_t = cpu::linprg::FlowType;
-    emp::vector<size_t> matches(
-      hw.FindModuleMatch(inst.GetTag(0))
-    );
-    if (matches.size()) {
-      const auto& target_module = hw.GetModule(matches[0]);
+    const auto match = hw.FindBestModuleMatch(inst.GetTag(0));
+    if (match) {
+      const auto& target_module = hw.GetModule(*match);
       // Flow: type mp ip begin end
       hw.GetFlowHandler().OpenFlow(
         hw,
@@ -413,7 +411,7 @@ struct Inst_Return : BaseInstructionSpec<Inst_Return<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -474,27 +472,76 @@ struct Inst_Fork : BaseInstructionSpec<Inst_Fork<HARDWARE_T>> {
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
-    const emp::vector<size_t> matches(hw.FindModuleMatch(inst.GetTag(0)));
-    if (matches.size()) {
-      auto spawned = hw.SpawnThreadWithID(matches[0]);
+    emp_assert(hw.GetCurThread().GetExecState().GetCallStack().size());
+    // NOTE: thread execution states never move (even if spawning grows thread storage), so it is
+    //       safe to hold on to forker across the spawn.
+    auto& forker = hw.GetCurThread().GetExecState().GetTopCallState();
+    const auto match = hw.FindBestModuleMatch(inst.GetTag(0));
+    if (match) {
+      auto spawned = hw.SpawnThreadWithID(*match);
       if (spawned) {
-        const size_t thread_id = spawned.value();
-        // Hold up there cowboy! If the module was empty, the hardware will ignore the CallModule request.
-        if (hw.GetThread(thread_id).GetExecState().GetCallStack().size()) {
-          // Spawned valid thread.
-          // Do whatever it is that the memory model says we should do on a function call.
-          emp_assert(hw.GetCurThread().GetExecState().GetCallStack().size());
-          auto& forker = hw.GetCurThread().GetExecState().GetTopCallState();
-          emp_assert(hw.GetThread(thread_id).GetExecState().GetCallStack().size());
-          auto& forkee = hw.GetThread(thread_id).GetExecState().GetTopCallState();
-          hw.GetMemoryModel().OnModuleCall(forker.GetMemory(), forkee.GetMemory());
-        }
+        // Do whatever it is that the memory model says we should do on a function call.
+        // NOTE: the spawned thread is not initialized until it is activated; the hardware stages
+        //       the forkee's memory until then (and drops it if the called module is empty).
+        hw.HandoffSpawnMemory(spawned.value(), forker.GetMemory());
       }
     }
   }
 
 };
 
+template<typename HARDWARE_T>
+struct Inst_WaitForEvent : BaseInstructionSpec<Inst_WaitForEvent<HARDWARE_T>> {
+  using hw_t = HARDWARE_T;
+  using inst_prop_t = inst::InstProperty;
+  using inst_t = typename HARDWARE_T::inst_t;
+
+  static std::string desc() {
+    return "Block the current thread until an event of type [arg0 mod number of event types] is handled.";
+  }
+
+  static std::string name() {
+    return "WaitForEvent";
+  }
+
+  static std::unordered_set<inst_prop_t> properties() {
+    return std::unordered_set<inst_prop_t>{};
+  }
+
+  static void run(hw_t& hw, const inst_t& inst) {
+    const int num_events = (int)hw.GetEventLib().GetSize();
+    if (!num_events) return;
+    int event_id = (int)inst.GetArg(0) % num_events;
+    if (event_id < 0) event_id += num_events;
+    hw.BlockCurThread((size_t)event_id);
+  }
+
+};
+
+template<typename HARDWARE_T>
+struct Inst_WaitForTag : BaseInstructionSpec<Inst_WaitForTag<HARDWARE_T>> {
+  using hw_t = HARDWARE_T;
+  using inst_prop_t = inst::InstProperty;
+  using inst_t = typename HARDWARE_T::inst_t;
+
+  static std::string desc() {
+    return "Block the current thread until it is woken by a tag that matches the same module as tag0.";
+  }
+
+  static std::string name() {
+    return "WaitForTag";
+  }
+
+  static std::unordered_set<inst_prop_t> properties() {
+    return std::unordered_set<inst_prop_t>{};
+  }
+
+  static void run(hw_t& hw, const inst_t& inst) {
+    hw.BlockCurThreadOnTag(inst.GetTag(0));
+  }
+
+};
+
 template<typename HARDWARE_T>
 struct Inst_Terminate : BaseInstructionSpec<Inst_Terminate<HARDWARE_T>> {
   using hw_t = HARDWARE_T;
@@ -510,7 +557,7 @@ struct Inst_Terminate : BaseInstructionSpec<Inst_Terminate<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -35,7 +35,7 @@ struct Inst_SetMem : BaseInstructionSpec<Inst_SetMem<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -61,7 +61,7 @@ struct Inst_CopyMem : BaseInstructionSpec<Inst_CopyMem<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -87,7 +87,7 @@ struct Inst_SwapMem : BaseInstructionSpec<Inst_SwapMem<HARDWARE_T>> {
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -116,7 +116,7 @@ struct Inst_InputToWorking : BaseInstructionSpec<Inst_InputToWorking<HARDWARE_T>
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
@@ -142,7 +142,7 @@ struct Inst_WorkingToOutput : BaseInstructionSpec<Inst_WorkingToOutput<HARDWARE_
   }
 
   static std::unordered_set<inst_prop_t> properties() {
-    return std::unordered_set<inst_prop_t>{};
+    return std::unordered_set<inst_prop_t>{inst_prop_t::THREAD_LOCAL};
   }
 
   static void run(hw_t& hw, const inst_t& inst) {
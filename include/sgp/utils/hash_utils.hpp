@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace sgp::utils {
+
+/// Scramble the bits of a hash value (the splitmix64 finalizer), so that similar inputs (e.g.,
+/// consecutive integers) give very different hashes.
+inline size_t HashMix(size_t value) {
+  uint64_t x = (uint64_t)value;
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return (size_t)x;
+}
+
+/// Combine the hash of value (via std::hash) into a running hash. Order matters:
+/// HashCombine(HashCombine(h, a), b) != HashCombine(HashCombine(h, b), a).
+template<typename T>
+size_t HashCombine(size_t seed, const T& value) {
+  return HashMix(seed ^ (std::hash<T>()(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+}
+
+/// Hash the contents of an unordered map (or any container of key-value pairs). The result does
+/// not depend on iteration order, so equal maps always hash equally.
+template<typename MAP_T>
+size_t HashUnorderedMap(const MAP_T& map) {
+  size_t hash = map.size();
+  for (const auto& [key, value] : map) hash += HashCombine(HashCombine(0, key), value);
+  return HashMix(hash);
+}
+
+/// Does REGULATOR_T have a countdown timer (as emp's countdown regulators do)?
+template<typename REGULATOR_T, typename=void>
+struct HasRegulatorTimer : std::false_type { };
+template<typename REGULATOR_T>
+struct HasRegulatorTimer<REGULATOR_T, std::void_t<decltype(std::declval<const REGULATOR_T&>().timer)>>
+  : std::true_type { };
+
+/// Combine the state of a matchbin regulator into a running hash: its view (i.e., its current
+/// regulation value) and, if it has one, its countdown timer (which decides when it decays).
+template<typename REGULATOR_T>
+size_t HashRegulator(size_t seed, const REGULATOR_T& regulator) {
+  seed = HashCombine(seed, regulator.View());
+  if constexpr (HasRegulatorTimer<REGULATOR_T>::value) seed = HashCombine(seed, regulator.timer);
+  return seed;
+}
+
+} // End sgp::utils namespace
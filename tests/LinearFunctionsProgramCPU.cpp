@@ -1,6 +1,8 @@
 #define CATCH_CONFIG_MAIN
 #include "catch2/catch.hpp"
 
+#include <utility>
+
 #include "emp/bits/BitSet.hpp"
 
 #include "sgp/inst/InstructionLibrary.hpp"
@@ -19,6 +21,9 @@ void AddBasicInstructions(INST_LIB_T& inst_lib) {
   inst_directory.AddAllDefaultInstructions(
     inst_lib
   );
+  inst_directory.AddAllSchedulingInstructions(
+    inst_lib
+  );
 }
 
 TEST_CASE("SignalGP - Linear Functions Program") {
@@ -1804,6 +1809,55 @@ TEST_CASE("SignalGP - Linear Functions Program") {
     ////////////////////////////////////////////////////////////////////////////
   }
 
+  SECTION ("Execution state recycling") {
+    std::cout << "-- Testing execution state recycling --" << std::endl;
+    ////////////////////////////////////////////////////////////////////////////
+    program.Clear();
+    hardware.Reset(); // Reset program & hardware.
+    tag_t zeros, ones;
+    ones.SetUInt(0, (uint16_t)-1);
+    program.PushFunction(zeros);
+    program.PushInst(inst_lib,   "SetMem", {2, 2});
+    program.PushInst(inst_lib,   "SetMem", {3, 3});
+    program.PushInst(inst_lib,   "Call", {0, 0, 0}, {ones});
+    program.PushFunction(ones);
+    program.PushInst(inst_lib,   "InputToWorking", {1, 2, 0});
+    program.PushInst(inst_lib,   "InputToWorking", {2, 3, 0});
+    program.PushInst(inst_lib,   "Inc", {1, 0, 0});
+    program.PushInst(inst_lib,   "Inc", {2, 0, 0});
+    program.PushInst(inst_lib,   "WorkingToOutput", {4, 1, 0});
+    program.PushInst(inst_lib,   "WorkingToOutput", {5, 2, 0});
+    hardware.SetProgram(program);
+    hardware.SetExecStateRecycling();
+    REQUIRE(hardware.IsExecStateRecyclingUsed());
+    // Recycled call states should behave exactly like new ones (run the same thread id repeatedly).
+    for (size_t rep = 0; rep < 3; ++rep) {
+      auto spawned = hardware.SpawnThreadWithID(0);
+      REQUIRE(spawned);
+      size_t thread_id = spawned.value();
+      for (size_t i = 0; i < 10; ++i) hardware.SingleProcess();
+      auto& exec_state = hardware.GetThread(thread_id).GetExecState();
+      REQUIRE(exec_state.GetCallStack().size() == 1);
+      REQUIRE(exec_state.GetTopCallState().GetMemory().working_mem
+          == mem_buffer_t({{4, 3.0}, {5, 4.0}, {2, 2.0}, {3, 3.0}}));
+      REQUIRE(exec_state.GetTopCallState().GetMemory().input_mem.empty());
+      // The callee's call state was recycled when it returned.
+      REQUIRE(exec_state.spare_call_states.size() == 1);
+      hardware.ProcessUntilIdle(10);
+      REQUIRE(hardware.GetNumActiveThreads() == 0);
+      REQUIRE(exec_state.GetCallStack().empty());
+      REQUIRE(exec_state.spare_call_states.size() == 2);
+      REQUIRE(hardware.ValidateThreadState());
+    }
+    // Without recycling, resetting threads discards recycled call states.
+    hardware.SetExecStateRecycling(false);
+    hardware.ResetThreads();
+    for (size_t id = 0; id < hardware.ViewThreads().size(); ++id) {
+      REQUIRE(hardware.GetThread(id).GetExecState().spare_call_states.empty());
+    }
+    ////////////////////////////////////////////////////////////////////////////
+  }
+
   SECTION ("Inst_Routine") {
     std::cout << "-- Testing Inst_Routine --" << std::endl;
     ////////////////////////////////////////////////////////////////////////////
@@ -2349,12 +2403,22 @@ TEST_CASE("SignalGP - Linear Functions Program") {
     REQUIRE(hardware.GetPendingThreadIDs().size() == 1);
     REQUIRE(hardware.GetActiveThreadIDs().size() == 1);
     REQUIRE(hardware.ValidateThreadState());
+    // Forked thread is not initialized until it is activated.
+    const size_t fork_id = hardware.GetPendingThreadIDs()[0];
+    REQUIRE(std::as_const(hardware).GetThread(fork_id).IsInitDeferred());
+    // Neither killing (a no-op for a pending thread) nor viewing threads initializes it.
+    REQUIRE(!hardware.KillActiveThread(fork_id));
+    REQUIRE(hardware.ViewThreads()[fork_id].IsInitDeferred());
     hardware.SingleProcess(); // [0]: SetMem(4,4), [1]: Nop
     REQUIRE(hardware.GetThread(thread_id).GetExecState().GetTopCallState().GetMemory().working_mem
         == mem_buffer_t({{2, 2.0}, {3, 3.0}, {4, 4.0}}));
     REQUIRE(hardware.GetPendingThreadIDs().size() == 0);
     REQUIRE(hardware.GetActiveThreadIDs().size() == 2);
     REQUIRE(hardware.ValidateThreadState());
+    // Forked thread's input memory should be the forker's working memory at the time of the fork.
+    REQUIRE(!hardware.GetThread(fork_id).IsInitDeferred());
+    REQUIRE(hardware.GetThread(fork_id).GetExecState().GetTopCallState().GetMemory().input_mem
+        == mem_buffer_t({{2, 2.0}, {3, 3.0}}));
     hardware.SingleProcess(); // [0]: DEAD, [1]: Fork
     REQUIRE(hardware.GetPendingThreadIDs().size() == 1);
     REQUIRE(hardware.GetActiveThreadIDs().size() == 1);
@@ -2454,5 +2518,160 @@ TEST_CASE("SignalGP - Linear Functions Program") {
     REQUIRE(hardware.ValidateThreadState());
     ////////////////////////////////////////////////////////////////////////////
   }
+
+  SECTION ("Thread quantum") {
+    std::cout << "-- Testing thread quantum --" << std::endl;
+    ////////////////////////////////////////////////////////////////////////////
+    program.Clear();
+    hardware.Reset(); // Reset program & hardware.
+    tag_t zeros, ones;
+    ones.SetUInt(0, (uint16_t)-1);
+    program.PushFunction(zeros);
+    program.PushInst(inst_lib,   "SetMem", {2, 2});
+    program.PushInst(inst_lib,   "SetMem", {3, 3});
+    program.PushInst(inst_lib,   "Fork", {0, 0, 0}, {ones});
+    program.PushInst(inst_lib,   "SetMem", {4, 4});
+    program.PushFunction(ones);
+    program.PushInst(inst_lib,   "Nop", {0, 0, 0});
+    program.PushInst(inst_lib,   "Nop", {0, 0, 0});
+    hardware.SetProgram(program);
+    hardware.SetThreadQuantum(8);
+    hardware.SetYieldOnThreadChange(true);
+    // Thread should yield after forking.
+    auto spawned = hardware.SpawnThreadWithID(0);
+    REQUIRE(spawned);
+    size_t thread_id = spawned.value();
+    hardware.SingleProcess(); // SetMem, SetMem, Fork (yield)
+    REQUIRE(hardware.GetThread(thread_id).GetExecState().GetTopCallState().GetMemory().working_mem
+        == mem_buffer_t({{2, 2.0}, {3, 3.0}}));
+    REQUIRE(hardware.GetPendingThreadIDs().size() == 1);
+    REQUIRE(hardware.GetActiveThreadIDs().size() == 1);
+    hardware.SingleProcess(); // [0]: SetMem, return (DEAD), [1]: Nop, Nop, return (DEAD)
+    REQUIRE(hardware.GetPendingThreadIDs().size() == 0);
+    REQUIRE(hardware.GetActiveThreadIDs().size() == 0);
+    REQUIRE(hardware.ValidateThreadState());
+    // Without yielding, thread should run to completion within its quantum.
+    hardware.SetYieldOnThreadChange(false);
+    REQUIRE(hardware.SpawnThreadWithID(0));
+    hardware.SingleProcess(); // SetMem, SetMem, Fork, SetMem, return (DEAD)
+    REQUIRE(hardware.GetPendingThreadIDs().size() == 1);
+    REQUIRE(hardware.GetActiveThreadIDs().size() == 0);
+    REQUIRE(hardware.ValidateThreadState());
+    ////////////////////////////////////////////////////////////////////////////
+  }
+
+  SECTION ("Module matches into a caller-provided buffer") {
+    std::cout << "-- Testing module matches into a caller-provided buffer --" << std::endl;
+    ////////////////////////////////////////////////////////////////////////////
+    program.Clear();
+    hardware.Reset(); // Reset program & hardware.
+    tag_t zeros, ones;
+    ones.SetUInt(0, (uint16_t)-1);
+    program.PushFunction(zeros);
+    program.PushInst(inst_lib,   "Nop", {0, 0, 0});
+    program.PushFunction(ones);
+    program.PushInst(inst_lib,   "Nop", {0, 0, 0});
+    hardware.SetProgram(program);
+    // Without a buffered FindModuleMatch, matches are copied into the buffer (keeping its storage).
+    emp::vector<size_t> matches;
+    matches.reserve(8);
+    const size_t* storage = matches.data();
+    hardware.FindModuleMatches(ones, 1, matches);
+    REQUIRE(matches == emp::vector<size_t>({1}));
+    REQUIRE(matches.data() == storage);
+    ////////////////////////////////////////////////////////////////////////////
+  }
+
+  SECTION ("Inst_WaitForEvent") {
+    std::cout << "-- Testing Inst_WaitForEvent --" << std::endl;
+    ////////////////////////////////////////////////////////////////////////////
+    program.Clear();
+    hardware.Reset(); // Reset program & hardware.
+    using event_t = typename signalgp_t::event_t;
+    event_lib.AddEvent("Ping", [](signalgp_t&, const event_t&) { ; });
+    const size_t msg_id = event_lib.AddEvent("Message", [](signalgp_t&, const event_t&) { ; });
+    tag_t zeros;
+    program.PushFunction(zeros);
+    program.PushInst(inst_lib,   "SetMem", {2, 2});
+    program.PushInst(inst_lib,   "WaitForEvent", {3, 0, 0}); // 3 mod 2 => Message
+    program.PushInst(inst_lib,   "SetMem", {3, 3});
+    hardware.SetProgram(program);
+    auto spawned = hardware.SpawnThreadWithID(0);
+    REQUIRE(spawned);
+    size_t thread_id = spawned.value();
+    hardware.SingleProcess(); // SetMem
+    hardware.SingleProcess(); // WaitForEvent (BLOCKED)
+    REQUIRE(hardware.GetThread(thread_id).IsBlocked());
+    REQUIRE(hardware.GetActiveThreadIDs().size() == 0);
+    REQUIRE(hardware.IsIdle());
+    REQUIRE(hardware.ValidateThreadState());
+    // Other events do not wake the thread.
+    hardware.QueueEvent(event_t(msg_id - 1));
+    hardware.SingleProcess();
+    REQUIRE(hardware.GetThread(thread_id).IsBlocked());
+    hardware.QueueEvent(event_t(msg_id));
+    hardware.SingleProcess(); // Wake, SetMem
+    REQUIRE(hardware.GetThread(thread_id).IsRunning());
+    REQUIRE(hardware.GetThread(thread_id).GetExecState().GetTopCallState().GetMemory().working_mem
+        == mem_buffer_t({{2, 2.0}, {3, 3.0}}));
+    hardware.SingleProcess(); // return (DEAD)
+    REQUIRE(hardware.GetActiveThreadIDs().size() == 0);
+    REQUIRE(hardware.GetNumBlockedThreads() == 0);
+    REQUIRE(hardware.ValidateThreadState());
+    ////////////////////////////////////////////////////////////////////////////
+  }
+
+  SECTION ("Inst_WaitForTag") {
+    std::cout << "-- Testing Inst_WaitForTag --" << std::endl;
+    ////////////////////////////////////////////////////////////////////////////
+    program.Clear();
+    hardware.Reset(); // Reset program & hardware.
+    // Events with a tag wake threads waiting on a matching tag when handled.
+    struct TagEvent : sgp::BaseEvent {
+      tag_t tag;
+      TagEvent(size_t _id, const tag_t& _tag) : sgp::BaseEvent(_id), tag(_tag) { ; }
+      const tag_t& GetTag() const { return tag; }
+    };
+    using event_t = typename signalgp_t::event_t;
+    const size_t msg_id = event_lib.AddEvent("TaggedMessage", [](signalgp_t&, const event_t&) { ; });
+    tag_t zeros, ones, mostly_ones;
+    ones.SetUInt(0, (uint16_t)-1);
+    mostly_ones.SetUInt(0, (uint16_t)-2);
+    program.PushFunction(zeros);
+    program.PushInst(inst_lib,   "SetMem", {2, 2});
+    program.PushInst(inst_lib,   "WaitForTag", {0, 0, 0}, {ones});
+    program.PushInst(inst_lib,   "SetMem", {3, 3});
+    program.PushFunction(ones);
+    program.PushInst(inst_lib,   "Nop", {0, 0, 0});
+    hardware.SetProgram(program);
+    auto spawned = hardware.SpawnThreadWithID(0);
+    REQUIRE(spawned);
+    size_t thread_id = spawned.value();
+    hardware.SingleProcess(); // SetMem
+    hardware.SingleProcess(); // WaitForTag (BLOCKED)
+    REQUIRE(hardware.GetThread(thread_id).IsBlocked());
+    REQUIRE(hardware.GetBlockedThreadIDs().GetKey(thread_id) == hardware.GetTagWaitKey(ones).value());
+    REQUIRE(hardware.IsIdle());
+    // Tags (and events) matching other modules do not wake the thread; events without tags wake
+    // threads by event id only.
+    REQUIRE(hardware.WakeThreadsWithTag(zeros) == 0);
+    hardware.HandleEvent(TagEvent(msg_id, zeros));
+    hardware.HandleEvent(event_t(msg_id));
+    REQUIRE(hardware.GetThread(thread_id).IsBlocked());
+    // A tag that best matches the same module does.
+    hardware.HandleEvent(TagEvent(msg_id, mostly_ones));
+    REQUIRE(hardware.GetNumBlockedThreads() == 0);
+    hardware.SingleProcess(); // Wake, SetMem
+    REQUIRE(hardware.GetThread(thread_id).IsRunning());
+    REQUIRE(hardware.GetThread(thread_id).GetExecState().GetTopCallState().GetMemory().working_mem
+        == mem_buffer_t({{2, 2.0}, {3, 3.0}}));
+    // Waiting (or waking) on a tag that matches no module does nothing.
+    hardware.SingleProcess(); // return (DEAD)
+    hardware.SetProgram(program_t());
+    REQUIRE(!hardware.GetTagWaitKey(ones));
+    REQUIRE(hardware.WakeThreadsWithTag(ones) == 0);
+    REQUIRE(hardware.ValidateThreadState());
+    ////////////////////////////////////////////////////////////////////////////
+  }
 }
 
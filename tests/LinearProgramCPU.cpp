@@ -1841,4 +1841,370 @@ TEST_CASE("SignalGP - Linear Program", "[general]") {
 
   // }
 
-}
\ No newline at end of file
+}
+TEST_CASE("SignalGP - Linear Program - Parallel thread execution", "[general]") {
+  using mem_model_t = sgp::cpu::mem::BasicMemoryModel;
+  using signalgp_t = sgp::cpu::LinearProgramCPU<
+    mem_model_t,
+    int,
+    emp::MatchBin<
+      size_t,
+      emp::HammingMetric<16>,
+      emp::RankedSelector<std::ratio<16+8, 16>>,
+      emp::AdditiveCountdownRegulator<>
+    >,
+    sgp::cpu::DefaultCustomComponent
+  >;
+  using inst_lib_t = typename signalgp_t::inst_lib_t;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+  using program_t = typename signalgp_t::program_t;
+  using tag_t = typename signalgp_t::tag_t;
+  using mem_buffer_t = typename mem_model_t::mem_buffer_t;
+
+  inst_lib_t inst_lib;
+  event_lib_t event_lib;
+  AddBasicInstructions(inst_lib);
+
+  // Threads interleave thread-local instructions with reads/writes of (shared) global memory and
+  // calls (which match tags), and their control flow diverges (depending on their inputs).
+  tag_t zeros, ones;
+  ones.SetUInt(0, (uint16_t)-1);
+  program_t program;
+  program.PushInst(inst_lib, "ModuleDef",  {0, 0, 0}, {zeros});
+  program.PushInst(inst_lib,   "Inc", {0, 0, 0});
+  program.PushInst(inst_lib,   "Add", {1, 0, 1});
+  program.PushInst(inst_lib,   "Mult", {2, 1, 0});
+  program.PushInst(inst_lib,   "SetMem", {5, 3});
+  program.PushInst(inst_lib,   "Mod", {4, 0, 5});
+  program.PushInst(inst_lib,   "If", {4, 0, 0});
+  program.PushInst(inst_lib,     "Inc", {6, 0, 0});
+  program.PushInst(inst_lib,     "Add", {6, 6, 0});
+  program.PushInst(inst_lib,   "Close", {0, 0, 0});
+  program.PushInst(inst_lib,   "CopyMem", {4, 7});
+  program.PushInst(inst_lib,   "Countdown", {7, 0, 0});
+  program.PushInst(inst_lib,     "Inc", {8, 0, 0});
+  program.PushInst(inst_lib,     "Dec", {7, 0, 0});
+  program.PushInst(inst_lib,   "Close", {0, 0, 0});
+  program.PushInst(inst_lib,   "WorkingToGlobal", {0, 1, 0});
+  program.PushInst(inst_lib,   "Inc", {1, 0, 0});
+  program.PushInst(inst_lib,   "GlobalToWorking", {3, 0, 0});
+  program.PushInst(inst_lib,   "Add", {2, 2, 3});
+  program.PushInst(inst_lib,   "Call", {0, 0, 0}, {ones});
+  program.PushInst(inst_lib,   "WorkingToGlobal", {1, 2, 0});
+  program.PushInst(inst_lib, "ModuleDef",  {0, 0, 0}, {ones});
+  program.PushInst(inst_lib,   "InputToWorking", {0, 2, 0});
+  program.PushInst(inst_lib,   "Inc", {0, 0, 0});
+  program.PushInst(inst_lib,   "Sub", {1, 0, 1});
+  program.PushInst(inst_lib,   "WorkingToOutput", {2, 0, 0});
+
+  // Run the program on the given hardware; return a trace of each running thread's working memory
+  // after every step (and the final global memory).
+  auto run = [&](signalgp_t& hardware) {
+    hardware.SetActiveThreadLimit(16);
+    hardware.SetThreadQuantum(6);
+    hardware.SetProgram(program);
+    emp::vector<std::pair<size_t, mem_buffer_t>> trace;
+    for (size_t step = 0; step < 60; ++step) {
+      for (size_t i = 0; i < 3; ++i) {
+        auto spawned = hardware.SpawnThreadWithID(0);
+        if (!spawned) continue;
+        hardware.GetThread(spawned.value()).GetExecState().GetTopCallState()
+                .GetMemory().SetWorking(0, (double)(step + i));
+      }
+      hardware.SingleProcess();
+      for (size_t id : hardware.GetThreadExecOrder()) {
+        auto& exec_state = hardware.GetThread(id).GetExecState();
+        trace.emplace_back(id, exec_state.GetTopCallState().GetMemory().working_mem);
+      }
+    }
+    REQUIRE(hardware.ValidateThreadState());
+    trace.emplace_back(hardware.GetNumSteps(), hardware.GetMemoryModel().GetGlobalBuffer());
+    return trace;
+  };
+
+  emp::Random serial_random(2);
+  signalgp_t serial_hw(serial_random, inst_lib, event_lib);
+  const auto serial_trace = run(serial_hw);
+
+  emp::Random parallel_random(2);
+  signalgp_t parallel_hw(parallel_random, inst_lib, event_lib);
+  parallel_hw.SetParallelExecution(4);
+  REQUIRE(parallel_hw.IsParallelExecutionUsed());
+  REQUIRE(run(parallel_hw) == serial_trace);
+
+  // A thread that executed ahead cannot be killed or blocked (by a thread before it in the
+  // execution order) until it has finished its turn.
+  using inst_t = typename signalgp_t::inst_t;
+  inst_lib.AddInst("KillOthers", [](signalgp_t& hw, const inst_t&) {
+    const size_t cur_id = hw.GetCurThreadID();
+    auto& mem = hw.GetCurThread().GetExecState().GetTopCallState().GetMemory();
+    const emp::vector<size_t> active_ids(hw.GetActiveThreadIDs().begin(), hw.GetActiveThreadIDs().end());
+    for (size_t id : active_ids) {
+      if (id == cur_id) continue;
+      mem.SetWorking(0, (double)hw.BlockThread(id, 0));
+      mem.SetWorking(1, (double)hw.KillActiveThread(id));
+    }
+  }, "Try to block and kill every other active thread");
+  program_t killer_program;
+  killer_program.PushInst(inst_lib, "ModuleDef",  {0, 0, 0}, {zeros});
+  killer_program.PushInst(inst_lib,   "KillOthers", {0, 0, 0});
+  killer_program.PushInst(inst_lib, "ModuleDef",  {0, 0, 0}, {ones});
+  killer_program.PushInst(inst_lib,   "Inc", {0, 0, 0});
+  killer_program.PushInst(inst_lib,   "Inc", {0, 0, 0});
+  for (signalgp_t* hw : {&serial_hw, &parallel_hw}) {
+    hw->Reset();
+    hw->SetProgram(killer_program);
+    hw->SetThreadQuantum(1);
+    const size_t killer_id = hw->SpawnThreadWithID(0).value();
+    const size_t victim_id = hw->SpawnThreadWithID(1).value();
+    hw->SingleProcess();
+    const auto& killer_mem = hw->GetThread(killer_id).GetExecState().GetTopCallState().GetMemory();
+    if (hw->IsParallelExecutionUsed()) {
+      // The victim (thread-local steps only) executed ahead, so it survives its turn.
+      REQUIRE(killer_mem.working_mem == mem_buffer_t({{0, 0.0}, {1, 0.0}}));
+      REQUIRE(hw->GetThread(victim_id).IsRunning());
+      REQUIRE(hw->GetThread(victim_id).GetExecState().GetTopCallState().GetMemory().GetWorking(0) == 1.0);
+    } else {
+      // In serial, the victim is blocked, then (once blocked) cannot be killed, before its turn.
+      REQUIRE(killer_mem.working_mem == mem_buffer_t({{0, 1.0}, {1, 0.0}}));
+      REQUIRE(hw->GetThread(victim_id).IsBlocked());
+    }
+    REQUIRE(hw->ValidateThreadState());
+  }
+}
+
+TEST_CASE("SignalGP - Linear Program - Snapshot and restore", "[general]") {
+  using mem_model_t = sgp::cpu::mem::BasicMemoryModel;
+  using signalgp_t = sgp::cpu::LinearProgramCPU<
+    mem_model_t,
+    int,
+    emp::MatchBin<
+      size_t,
+      emp::HammingMetric<16>,
+      emp::RankedSelector<std::ratio<16+8, 16>>,
+      emp::AdditiveCountdownRegulator<>
+    >,
+    sgp::cpu::DefaultCustomComponent
+  >;
+  using inst_lib_t = typename signalgp_t::inst_lib_t;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+  using program_t = typename signalgp_t::program_t;
+  using tag_t = typename signalgp_t::tag_t;
+  using mem_buffer_t = typename mem_model_t::mem_buffer_t;
+  using regulator_t = typename signalgp_t::regulator_t;
+
+  inst_lib_t inst_lib;
+  event_lib_t event_lib;
+  AddBasicInstructions(inst_lib);
+
+  tag_t zeros, ones;
+  ones.SetUInt(0, (uint16_t)-1);
+  program_t program;
+  program.PushInst(inst_lib, "ModuleDef",  {0, 0, 0}, {zeros});
+  program.PushInst(inst_lib,   "GlobalToWorking", {0, 0, 0});
+  program.PushInst(inst_lib,   "Inc", {0, 0, 0});
+  program.PushInst(inst_lib,   "Add", {1, 0, 1});
+  program.PushInst(inst_lib,   "WorkingToGlobal", {0, 0, 0});
+  program.PushInst(inst_lib,   "Call", {0, 0, 0}, {ones});
+  program.PushInst(inst_lib,   "WorkingToGlobal", {1, 1, 0});
+  program.PushInst(inst_lib, "ModuleDef",  {0, 0, 0}, {ones});
+  program.PushInst(inst_lib,   "InputToWorking", {0, 1, 0});
+  program.PushInst(inst_lib,   "Mult", {1, 0, 0});
+  program.PushInst(inst_lib,   "WorkingToOutput", {1, 1, 0});
+
+  emp::Random random(3);
+  signalgp_t hardware(random, inst_lib, event_lib);
+  hardware.SetActiveThreadLimit(8);
+  hardware.SetThreadQuantum(3);
+  hardware.SetProgram(program);
+
+  // Run a trial; return a trace of each running thread's working memory after every step (and the
+  // final global memory and module regulators). Regulators decay every few steps, so their timers
+  // matter.
+  auto run_trial = [&hardware]() {
+    emp::vector<std::pair<size_t, mem_buffer_t>> trace;
+    for (size_t step = 0; step < 40; ++step) {
+      if (step % 3 == 0) hardware.SpawnThreadWithID(0);
+      if (step % 5 == 4) hardware.GetMatchBin().DecayRegulators();
+      hardware.SingleProcess();
+      for (size_t id : hardware.GetThreadExecOrder()) {
+        trace.emplace_back(id, hardware.GetThread(id).GetExecState().GetTopCallState().GetMemory().working_mem);
+      }
+    }
+    REQUIRE(hardware.ValidateThreadState());
+    trace.emplace_back(hardware.GetNumSteps(), hardware.GetMemoryModel().GetGlobalBuffer());
+    emp::vector<regulator_t> regulators;
+    for (size_t i = 0; i < hardware.GetNumModules(); ++i) regulators.emplace_back(hardware.GetRegulator(i));
+    return std::make_pair(trace, regulators);
+  };
+
+  // Warm up, then snapshot.
+  for (size_t i = 0; i < 4; ++i) hardware.SpawnThreadWithID(0);
+  hardware.Process(10);
+  hardware.GetMatchBin().AdjRegulator(1, 2.0);
+  const auto snapshot = hardware.Snapshot();
+  REQUIRE(snapshot.regulators.size() == 2);
+  REQUIRE(snapshot.regulators[1] == hardware.GetRegulator(1));
+
+  const auto trial = run_trial();
+  REQUIRE(hardware.GetMemoryModel().GetGlobalBuffer() != snapshot.memory_model.GetGlobalBuffer());
+  hardware.Restore(snapshot);
+  REQUIRE(hardware.GetNumSteps() == 10);
+  REQUIRE(hardware.GetMemoryModel().GetGlobalBuffer() == snapshot.memory_model.GetGlobalBuffer());
+  // Regulators are restored whole (e.g., with their timers), not just their values.
+  for (size_t i = 0; i < hardware.GetNumModules(); ++i) {
+    REQUIRE(hardware.GetRegulator(i) == snapshot.regulators[i]);
+  }
+  REQUIRE(run_trial() == trial);
+  hardware.Restore(snapshot);
+  REQUIRE(run_trial() == trial);
+}
+
+TEST_CASE("SignalGP - Linear Program - State cycle detection", "[general]") {
+  using mem_model_t = sgp::cpu::mem::BasicMemoryModel;
+  using signalgp_t = sgp::cpu::LinearProgramCPU<
+    mem_model_t,
+    int,
+    emp::MatchBin<
+      size_t,
+      emp::HammingMetric<16>,
+      emp::RankedSelector<std::ratio<16+8, 16>>,
+      emp::AdditiveCountdownRegulator<>
+    >,
+    sgp::cpu::DefaultCustomComponent
+  >;
+  using inst_lib_t = typename signalgp_t::inst_lib_t;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+  using program_t = typename signalgp_t::program_t;
+  using tag_t = typename signalgp_t::tag_t;
+  using budget_t = sgp::cpu::sched::ProcessBudget;
+  using stop_reason_t = sgp::cpu::sched::ProcessStopReason;
+
+  inst_lib_t inst_lib;
+  event_lib_t event_lib;
+  AddBasicInstructions(inst_lib);
+
+  // Livelock: a while loop that toggles a value forever (and calls a module that does nothing).
+  tag_t zeros, ones;
+  ones.SetUInt(0, (uint16_t)-1);
+  program_t stuck_program;
+  stuck_program.PushInst(inst_lib, "ModuleDef", {0, 0, 0}, {zeros});
+  stuck_program.PushInst(inst_lib,   "SetMem", {0, 1});
+  stuck_program.PushInst(inst_lib,   "While", {0, 0, 0});
+  stuck_program.PushInst(inst_lib,     "Not", {1, 0, 0});
+  stuck_program.PushInst(inst_lib,     "Call", {0, 0, 0}, {ones});
+  stuck_program.PushInst(inst_lib,   "Close", {0, 0, 0});
+  stuck_program.PushInst(inst_lib, "ModuleDef", {0, 0, 0}, {ones});
+  stuck_program.PushInst(inst_lib,   "Nop", {0, 0, 0});
+  // Productive: a while loop that keeps counting.
+  program_t counting_program;
+  counting_program.PushInst(inst_lib, "ModuleDef", {0, 0, 0}, {zeros});
+  counting_program.PushInst(inst_lib,   "SetMem", {0, 1});
+  counting_program.PushInst(inst_lib,   "While", {0, 0, 0});
+  counting_program.PushInst(inst_lib,     "Inc", {1, 0, 0});
+  counting_program.PushInst(inst_lib,     "WorkingToGlobal", {1, 0, 0});
+  counting_program.PushInst(inst_lib,   "Close", {0, 0, 0});
+
+  emp::Random random(4);
+  signalgp_t hardware(random, inst_lib, event_lib);
+  REQUIRE(!hardware.IsCycleDetectionUsed());
+  for (size_t check_interval : {1, 3}) {
+    hardware.SetProgram(stuck_program);
+    hardware.SetCycleDetection(true, check_interval);
+    hardware.SetHaltOnCycle(true);
+    for (size_t i = 0; i < 2; ++i) hardware.SpawnThreadWithID(0);
+    auto result = hardware.ProcessFor(budget_t::Steps(10000));
+    REQUIRE(result.reason == stop_reason_t::HALTED);
+    REQUIRE(result.num_steps < 200);
+    REQUIRE(hardware.IsCycleDetected());
+    REQUIRE(hardware.IsHalted());
+    REQUIRE(hardware.GetCycleLength() > 0);
+    REQUIRE(hardware.GetCycleLength() % check_interval == 0);
+    // The state really does recur.
+    const size_t state_hash = hardware.GetStateHash();
+    const size_t num_steps = hardware.GetNumSteps();
+    hardware.SingleProcess();
+    REQUIRE(hardware.GetNumSteps() == num_steps); // Halted.
+    const size_t cycle_length = hardware.GetCycleLength();
+    hardware.ResetCycleDetection();
+    REQUIRE(!hardware.IsHalted());
+    REQUIRE(!hardware.IsCycleDetected());
+    hardware.SetCycleDetection(false);
+    hardware.Process(cycle_length);
+    REQUIRE(hardware.GetNumActiveThreads() == 2);
+    REQUIRE(hardware.GetStateHash() == state_hash);
+    hardware.SingleProcess();
+    REQUIRE(hardware.GetStateHash() != state_hash);
+  }
+  // Regulators are part of the state, including their timers (setting a regulator to its current
+  // value restarts its timer).
+  const size_t state_hash = hardware.GetStateHash();
+  hardware.GetMatchBin().SetRegulator(1, hardware.GetRegulator(1).View());
+  REQUIRE(hardware.GetStateHash() != state_hash);
+
+  // Productive programs are not flagged.
+  hardware.SetProgram(counting_program);
+  hardware.SetCycleDetection(true);
+  hardware.SetHaltOnCycle(false);
+  hardware.SpawnThreadWithID(0);
+  auto result = hardware.ProcessFor(budget_t::Steps(2000));
+  REQUIRE(result.reason == stop_reason_t::STEPS);
+  REQUIRE(!hardware.IsCycleDetected());
+  // Without halting, detection only flags the cycle.
+  hardware.SetProgram(stuck_program);
+  hardware.SetCycleDetection(true);
+  hardware.SpawnThreadWithID(0);
+  hardware.Process(500);
+  REQUIRE(hardware.IsCycleDetected());
+  REQUIRE(!hardware.IsHalted());
+  REQUIRE(hardware.GetNumSteps() == 500);
+  // Reset clears detection.
+  hardware.Reset();
+  REQUIRE(!hardware.IsCycleDetected());
+
+  // A hardware that is waiting (idle, or with every thread blocked) is not livelocked: it is never
+  // halted, and it goes on to run threads spawned later.
+  program_t finishing_program;
+  finishing_program.PushInst(inst_lib, "ModuleDef", {0, 0, 0}, {zeros});
+  finishing_program.PushInst(inst_lib,   "SetMem", {0, 1});
+  finishing_program.PushInst(inst_lib,   "Inc", {0, 0, 0});
+  finishing_program.PushInst(inst_lib,   "Inc", {0, 0, 0});
+  finishing_program.PushInst(inst_lib,   "WorkingToGlobal", {0, 0, 0});
+  hardware.SetProgram(finishing_program);
+  hardware.SetCycleDetection(true);
+  hardware.SetHaltOnCycle(true);
+  hardware.SpawnThreadWithID(0);
+  result = hardware.ProcessFor(budget_t::Steps(100));
+  REQUIRE(result.reason == stop_reason_t::IDLE);
+  REQUIRE(hardware.IsIdle());
+  hardware.Process(50);
+  REQUIRE(!hardware.IsHalted());
+  REQUIRE(!hardware.IsCycleDetected());
+  size_t num_steps = hardware.GetNumSteps();
+  const auto spawned = hardware.SpawnThreadWithID(0);
+  REQUIRE(spawned);
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetNumSteps() == num_steps + 1);
+  REQUIRE(hardware.GetNumActiveThreads() == 1);
+  REQUIRE(hardware.BlockThread(spawned.value(), 7));
+  hardware.Process(50);
+  REQUIRE(hardware.GetNumActiveThreads() == 0);
+  REQUIRE(!hardware.IsHalted());
+  REQUIRE(!hardware.IsCycleDetected());
+  REQUIRE(hardware.WakeThread(spawned.value()));
+  result = hardware.ProcessFor(budget_t::Steps(100));
+  REQUIRE(result.reason == stop_reason_t::IDLE);
+  REQUIRE(!hardware.IsHalted());
+  // Spawning a thread (from outside of execution) resumes a halted hardware.
+  hardware.SetProgram(stuck_program);
+  hardware.SpawnThreadWithID(0);
+  result = hardware.ProcessFor(budget_t::Steps(10000));
+  REQUIRE(result.reason == stop_reason_t::HALTED);
+  num_steps = hardware.GetNumSteps();
+  REQUIRE(hardware.SpawnThreadWithID(0));
+  REQUIRE(!hardware.IsHalted());
+  REQUIRE(!hardware.IsCycleDetected());
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetNumSteps() == num_steps + 1);
+  REQUIRE(hardware.GetNumActiveThreads() == 2);
+}
@@ -0,0 +1,602 @@
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <unordered_set>
+
+#include "emp/math/Random.hpp"
+#include "emp/base/vector.hpp"
+
+#include "sgp/cpu/sched/ChunkedArray.hpp"
+#include "sgp/cpu/sched/CycleDetector.hpp"
+#include "sgp/cpu/sched/DenseIDSet.hpp"
+#include "sgp/cpu/sched/FixedVector.hpp"
+#include "sgp/cpu/sched/IndexedHeap.hpp"
+#include "sgp/cpu/sched/PriorityBuckets.hpp"
+#include "sgp/cpu/sched/RingBuffer.hpp"
+#include "sgp/cpu/sched/RunList.hpp"
+#include "sgp/cpu/sched/ThreadMembership.hpp"
+#include "sgp/cpu/sched/ThreadTable.hpp"
+#include "sgp/cpu/sched/TimingWheel.hpp"
+#include "sgp/cpu/sched/WaitLists.hpp"
+
+TEST_CASE("ChunkedArray", "[sched]") {
+  using array_t = sgp::cpu::sched::ChunkedArray<emp::vector<int>, 2>;
+  array_t values(3);
+  REQUIRE(values.size() == 3);
+  REQUIRE(values.GetCapacity() == 4);
+  values[0].emplace_back(1);
+  values[2].emplace_back(3);
+  emp::vector<int>* first = &values[0];
+  // Growing never moves existing elements.
+  for (size_t n = 4; n <= 64; ++n) {
+    values.Resize(n);
+    values[n - 1].emplace_back((int)n);
+    REQUIRE(&values[0] == first);
+  }
+  REQUIRE(values.GetCapacity() == 64);
+  REQUIRE(values[0] == emp::vector<int>({1}));
+  REQUIRE(values[63] == emp::vector<int>({64}));
+  // Copies are deep.
+  array_t copy(values);
+  copy[0].emplace_back(2);
+  REQUIRE(values[0].size() == 1);
+  REQUIRE(copy[63] == emp::vector<int>({64}));
+  // Shrinking resets dropped elements in kept chunks.
+  values.Resize(5);
+  REQUIRE(values.GetCapacity() == 8);
+  values.Resize(8);
+  REQUIRE(values[4] == emp::vector<int>({5}));
+  REQUIRE(values[5].empty());
+  REQUIRE(values[7].empty());
+  REQUIRE(&values[0] == first);
+}
+
+TEST_CASE("DenseIDSet", "[sched]") {
+  sgp::cpu::sched::DenseIDSet ids(16);
+  REQUIRE(ids.GetCapacity() == 16);
+  REQUIRE(ids.empty());
+  REQUIRE(ids.Insert(3));
+  REQUIRE(ids.Insert(7));
+  REQUIRE(ids.Insert(0));
+  REQUIRE(!ids.Insert(7));
+  REQUIRE(ids.size() == 3);
+  REQUIRE(ids.Has(0));
+  REQUIRE(ids.Has(3));
+  REQUIRE(ids.Has(7));
+  REQUIRE(!ids.Has(1));
+  REQUIRE(!ids.Has(100)); // Out-of-range ids are never members.
+  REQUIRE(ids.Erase(3));
+  REQUIRE(!ids.Erase(3));
+  REQUIRE(!ids.Has(3));
+  REQUIRE(ids.size() == 2);
+  emp::vector<size_t> members(ids.begin(), ids.end());
+  std::sort(members.begin(), members.end());
+  REQUIRE(members == emp::vector<size_t>({0, 7}));
+
+  // Shrinking capacity drops out-of-range members; growing preserves members.
+  ids.Insert(15);
+  ids.Insert(12);
+  ids.Resize(10);
+  REQUIRE(ids.size() == 2);
+  REQUIRE(!ids.Has(15));
+  REQUIRE(!ids.Has(12));
+  ids.Resize(32);
+  REQUIRE(ids.Has(0));
+  REQUIRE(ids.Has(7));
+  REQUIRE(ids.Insert(31));
+  ids.Clear();
+  REQUIRE(ids.empty());
+  REQUIRE(!ids.Has(31));
+
+  // Randomized comparison against std::unordered_set.
+  emp::Random random(1);
+  std::unordered_set<size_t> reference;
+  for (size_t i = 0; i < 10000; ++i) {
+    const size_t id = random.GetUInt(32);
+    if (random.P(0.5)) {
+      REQUIRE(ids.Insert(id) == reference.emplace(id).second);
+    } else {
+      REQUIRE(ids.Erase(id) == (bool)reference.erase(id));
+    }
+    REQUIRE(ids.size() == reference.size());
+  }
+  for (size_t id : ids) REQUIRE(reference.count(id));
+}
+
+TEST_CASE("IndexedHeap", "[sched]") {
+  using key_t = std::tuple<double, size_t>;
+  sgp::cpu::sched::IndexedHeap<key_t> max_heap(16);
+  sgp::cpu::sched::IndexedHeap<key_t, std::greater<key_t>> min_heap(16);
+  const emp::vector<double> priorities({1.0, 3.0, 2.0, 3.0, 0.5});
+  for (size_t id = 0; id < priorities.size(); ++id) {
+    max_heap.Push(id, {priorities[id], id});
+    min_heap.Push(id, {priorities[id], id});
+  }
+  REQUIRE(max_heap.size() == 5);
+  REQUIRE(max_heap.Top() == 3); // Ties go to the larger id in a max heap...
+  REQUIRE(min_heap.Top() == 4);
+  min_heap.Update(4, {3.0, 4});
+  REQUIRE(min_heap.Top() == 0);
+  min_heap.Update(0, {3.0, 0});
+  REQUIRE(min_heap.Top() == 2);
+  min_heap.Update(1, {1.0, 1});
+  REQUIRE(min_heap.Top() == 1);
+  REQUIRE(min_heap.Remove(1));
+  REQUIRE(!min_heap.Remove(1));
+  REQUIRE(!min_heap.Has(1));
+  REQUIRE(min_heap.Pop() == 2);
+  REQUIRE(min_heap.Pop() == 0); // ...and to the smaller id in a min heap.
+  REQUIRE(max_heap.Pop() == 3);
+  REQUIRE(max_heap.Pop() == 1);
+  max_heap.Resize(2);
+  REQUIRE(max_heap.size() == 1);
+  REQUIRE(max_heap.Top() == 0);
+  max_heap.Clear();
+  REQUIRE(max_heap.empty());
+
+  // Randomized comparison against sorting.
+  emp::Random random(1);
+  sgp::cpu::sched::IndexedHeap<key_t> heap(64);
+  emp::vector<double> reference(64, -1.0);
+  for (size_t i = 0; i < 5000; ++i) {
+    const size_t id = random.GetUInt(64);
+    const double priority = (double)random.GetUInt(8);
+    if (random.P(0.1) && heap.size()) {
+      const size_t top = heap.Pop();
+      key_t best(-1.0, 0);
+      for (size_t j = 0; j < reference.size(); ++j) {
+        if (reference[j] >= 0 && key_t(reference[j], j) > best) best = key_t(reference[j], j);
+      }
+      REQUIRE(std::get<1>(best) == top);
+      reference[top] = -1.0;
+    } else if (heap.Has(id)) {
+      if (random.P(0.5)) { heap.Update(id, {priority, id}); reference[id] = priority; }
+      else { heap.Remove(id); reference[id] = -1.0; }
+    } else {
+      heap.Push(id, {priority, id});
+      reference[id] = priority;
+    }
+    REQUIRE(heap.size() == (size_t)std::count_if(reference.begin(), reference.end(), [](double p) { return p >= 0; }));
+  }
+}
+
+TEST_CASE("FixedVector", "[sched]") {
+  sgp::cpu::sched::FixedVector<size_t, 8> vec(3, 7);
+  REQUIRE(vec.size() == 3);
+  REQUIRE(vec.capacity() == 8);
+  REQUIRE(emp::vector<size_t>(vec.begin(), vec.end()) == emp::vector<size_t>({7, 7, 7}));
+  vec.emplace_back(1);
+  vec.push_back(2);
+  REQUIRE(vec.back() == 2);
+  vec.pop_back();
+  REQUIRE(vec.back() == 1);
+  vec.resize(2);
+  vec.resize(4);
+  // Dropped elements are reset.
+  REQUIRE(emp::vector<size_t>(vec.begin(), vec.end()) == emp::vector<size_t>({7, 7, 0, 0}));
+  vec.clear();
+  REQUIRE(vec.empty());
+
+  // Fixed-capacity variants of the scheduling structures behave like the dynamic ones.
+  sgp::cpu::sched::RingBuffer<size_t, 4> ring;
+  REQUIRE(ring.GetCapacity() == 4);
+  for (size_t i = 0; i < 4; ++i) ring.PushBack(i);
+  ring.PopFront();
+  ring.PushBack(4); // Wraps around.
+  REQUIRE(emp::vector<size_t>(ring.begin(), ring.end()) == emp::vector<size_t>({1, 2, 3, 4}));
+
+  emp::Random random(3);
+  sgp::cpu::sched::DenseIDSet set(32);
+  sgp::cpu::sched::BasicDenseIDSet<32> fixed_set(32);
+  sgp::cpu::sched::RunList list(32);
+  sgp::cpu::sched::BasicRunList<32> fixed_list(32);
+  sgp::cpu::sched::IndexedHeap<double> heap(32);
+  sgp::cpu::sched::IndexedHeap<double, std::less<double>, 32> fixed_heap(32);
+  for (size_t i = 0; i < 5000; ++i) {
+    const size_t id = random.GetUInt(32);
+    if (set.Has(id)) {
+      set.Erase(id);
+      fixed_set.Erase(id);
+      list.Remove(id);
+      fixed_list.Remove(id);
+      heap.Remove(id);
+      fixed_heap.Remove(id);
+    } else {
+      const double key = random.GetDouble();
+      set.Insert(id);
+      fixed_set.Insert(id);
+      list.PushBack(id);
+      fixed_list.PushBack(id);
+      heap.Push(id, key);
+      fixed_heap.Push(id, key);
+    }
+    REQUIRE(std::equal(set.begin(), set.end(), fixed_set.begin(), fixed_set.end()));
+    REQUIRE(std::equal(list.begin(), list.end(), fixed_list.begin(), fixed_list.end()));
+    REQUIRE(heap.size() == fixed_heap.size());
+    if (heap.size()) REQUIRE(heap.Top() == fixed_heap.Top());
+  }
+}
+
+TEST_CASE("RingBuffer", "[sched]") {
+  sgp::cpu::sched::RingBuffer<size_t> ring(4);
+  REQUIRE(ring.empty());
+  for (size_t i = 0; i < 4; ++i) ring.PushBack(i);
+  REQUIRE(ring.GetCapacity() == 4);
+  ring.PopFront();
+  ring.PushBack(4); // Wraps around.
+  REQUIRE(ring.GetCapacity() == 4);
+  REQUIRE(emp::vector<size_t>(ring.begin(), ring.end()) == emp::vector<size_t>({1, 2, 3, 4}));
+  ring.PushBack(5); // Grows.
+  REQUIRE(ring.GetCapacity() >= 5);
+  REQUIRE(emp::vector<size_t>(ring.begin(), ring.end()) == emp::vector<size_t>({1, 2, 3, 4, 5}));
+  REQUIRE(ring.Front() == 1);
+  REQUIRE(ring.Back() == 5);
+  ring.PopBack();
+  REQUIRE(ring.Back() == 4);
+  REQUIRE(ring[1] == 2);
+  ring.Clear();
+  REQUIRE(ring.empty());
+
+  // Randomized comparison against std::deque.
+  emp::Random random(1);
+  std::deque<size_t> reference;
+  for (size_t i = 0; i < 10000; ++i) {
+    const double r = random.GetDouble();
+    if (r < 0.5) {
+      ring.PushBack(i);
+      reference.push_back(i);
+    } else if (r < 0.8 && reference.size()) {
+      REQUIRE(ring.Front() == reference.front());
+      ring.PopFront();
+      reference.pop_front();
+    } else if (reference.size()) {
+      REQUIRE(ring.Back() == reference.back());
+      ring.PopBack();
+      reference.pop_back();
+    }
+    REQUIRE(ring.size() == reference.size());
+  }
+  REQUIRE(std::equal(ring.begin(), ring.end(), reference.begin(), reference.end()));
+}
+
+TEST_CASE("WaitLists", "[sched]") {
+  using wait_lists_t = sgp::cpu::sched::WaitLists;
+  wait_lists_t waiting(8);
+  REQUIRE(waiting.empty());
+  REQUIRE(waiting.Front(3) == wait_lists_t::npos);
+  waiting.Insert(5, 3);
+  waiting.Insert(1, 3);
+  waiting.Insert(2, 100);
+  REQUIRE(waiting.size() == 3);
+  REQUIRE(waiting.Has(5));
+  REQUIRE(!waiting.Has(0));
+  REQUIRE(waiting.GetKey(1) == 3);
+  REQUIRE(waiting.Front(3) == 5); // FIFO per key.
+  REQUIRE(waiting.Next(5) == 1);
+  REQUIRE(waiting.Next(1) == wait_lists_t::npos);
+  REQUIRE(waiting.HasWaiting(100));
+  REQUIRE(!waiting.HasWaiting(4));
+  REQUIRE(waiting.Remove(5));
+  REQUIRE(!waiting.Remove(5));
+  REQUIRE(waiting.Front(3) == 1);
+  waiting.Insert(5, 3);
+  REQUIRE(waiting.Front(3) == 1);
+  // Shrinking capacity drops out-of-range ids.
+  waiting.Resize(4);
+  REQUIRE(waiting.size() == 2);
+  REQUIRE(waiting.Front(3) == 1);
+  waiting.Remove(1);
+  REQUIRE(!waiting.HasWaiting(3));
+  waiting.Resize(8);
+  waiting.Clear();
+  REQUIRE(waiting.empty());
+  REQUIRE(!waiting.Has(2));
+  REQUIRE(!waiting.HasWaiting(100));
+
+  // Randomized comparison against per-key std::deques.
+  emp::Random random(1);
+  std::map<size_t, std::deque<size_t>> reference;
+  emp::vector<size_t> keys(8, wait_lists_t::npos);
+  for (size_t i = 0; i < 10000; ++i) {
+    const size_t id = random.GetUInt(8);
+    if (waiting.Has(id)) {
+      REQUIRE(keys[id] != wait_lists_t::npos);
+      REQUIRE(waiting.GetKey(id) == keys[id]);
+      auto& ref_list = reference[keys[id]];
+      ref_list.erase(std::find(ref_list.begin(), ref_list.end(), id));
+      waiting.Remove(id);
+      keys[id] = wait_lists_t::npos;
+    } else {
+      REQUIRE(keys[id] == wait_lists_t::npos);
+      const size_t key = random.GetUInt(4);
+      waiting.Insert(id, key);
+      reference[key].push_back(id);
+      keys[id] = key;
+    }
+    size_t total = 0;
+    for (const auto& entry : reference) {
+      total += entry.second.size();
+      REQUIRE(waiting.Front(entry.first) == (entry.second.size() ? entry.second.front() : wait_lists_t::npos));
+    }
+    REQUIRE(waiting.size() == total);
+  }
+}
+
+TEST_CASE("TimingWheel", "[sched]") {
+  using wheel_t = sgp::cpu::sched::TimingWheel<size_t>;
+  wheel_t wheel;
+  emp::vector<size_t> expired;
+  auto collect = [&expired](size_t&& value) { expired.emplace_back(value); };
+  REQUIRE(wheel.empty());
+  wheel.Insert(0, 10);
+  wheel.Insert(2, 12);
+  wheel.Insert(0, 11);
+  wheel.Insert(100, 13);
+  REQUIRE(wheel.size() == 4);
+  wheel.Advance(collect);
+  REQUIRE(wheel.GetTime() == 1);
+  REQUIRE(expired == emp::vector<size_t>({10, 11}));
+  wheel.Insert(0, 14); // In the past: expires at the next Advance.
+  wheel.Advance(collect);
+  REQUIRE(expired == emp::vector<size_t>({10, 11, 14}));
+  wheel.Advance(collect);
+  REQUIRE(expired == emp::vector<size_t>({10, 11, 14, 12}));
+  while (wheel.GetTime() < 100) wheel.Advance(collect);
+  REQUIRE(expired.size() == 4);
+  wheel.Advance(collect);
+  REQUIRE(expired.back() == 13);
+  REQUIRE(wheel.empty());
+  wheel.Insert(200, 0);
+  wheel.Reset();
+  REQUIRE(wheel.empty());
+  REQUIRE(wheel.GetTime() == 0);
+
+  // Randomized: items (including items beyond the range of the wheel) expire exactly at their
+  // scheduled times, in insertion order.
+  emp::Random random(1);
+  emp::vector<size_t> times;  // Item value => scheduled time.
+  size_t last_time = 0;
+  size_t last_value = 0;
+  bool ok = true;
+  auto check = [&](size_t&& value) {
+    const size_t time = wheel.GetTime() - 1;
+    if (times[value] != time) ok = false;
+    if (time == last_time && value < last_value) ok = false;
+    last_time = time;
+    last_value = value;
+  };
+  auto schedule = [&](size_t time) {
+    wheel.Insert(time, times.size());
+    times.emplace_back(time);
+  };
+  const size_t far = size_t(1) << (wheel_t::LEVEL_BITS * wheel_t::NUM_LEVELS);
+  for (size_t i = 0; i < 2000; ++i) {
+    const double r = random.GetDouble();
+    if (r < 0.5) schedule(random.GetUInt(200));
+    else if (r < 0.9) schedule(random.GetUInt(100000));
+    else schedule(random.GetUInt(2 * far + 1000));
+  }
+  schedule(far);
+  schedule(far - 1);
+  while (wheel.size()) {
+    if (random.P(0.001)) schedule(wheel.GetTime() + random.GetUInt(5000));
+    wheel.Advance(check);
+  }
+  REQUIRE(ok);
+  REQUIRE(last_time == *std::max_element(times.begin(), times.end()));
+}
+
+TEST_CASE("RunList", "[sched]") {
+  using run_list_t = sgp::cpu::sched::RunList;
+  run_list_t runs(8);
+  REQUIRE(runs.empty());
+  REQUIRE(runs.Front() == run_list_t::npos);
+  runs.PushBack(3);
+  runs.PushBack(1);
+  runs.PushBack(6);
+  runs.PushBack(0);
+  REQUIRE(emp::vector<size_t>(runs.begin(), runs.end()) == emp::vector<size_t>({3, 1, 6, 0}));
+  const size_t version = runs.GetVersion();
+  REQUIRE(runs.Remove(6));
+  REQUIRE(!runs.Remove(6));
+  REQUIRE(runs.GetVersion() != version);
+  REQUIRE(runs.Next(1) == 0);
+  REQUIRE(runs.Prev(0) == 1);
+  REQUIRE(runs.Remove(3));
+  REQUIRE(runs.Front() == 1);
+  REQUIRE(runs.Back() == 0);
+  runs.PushBack(7);
+  runs.Resize(4); // Drops 7.
+  REQUIRE(emp::vector<size_t>(runs.begin(), runs.end()) == emp::vector<size_t>({1, 0}));
+  runs.Clear();
+  REQUIRE(runs.empty());
+  REQUIRE(!runs.Has(1));
+
+  // Randomized comparison against std::list.
+  runs.Resize(32);
+  emp::Random random(1);
+  std::list<size_t> reference;
+  for (size_t i = 0; i < 10000; ++i) {
+    const size_t id = random.GetUInt(32);
+    if (runs.Has(id)) {
+      runs.Remove(id);
+      reference.remove(id);
+    } else {
+      runs.PushBack(id);
+      reference.push_back(id);
+    }
+    REQUIRE(runs.size() == reference.size());
+  }
+  REQUIRE(std::equal(runs.begin(), runs.end(), reference.begin(), reference.end()));
+}
+
+TEST_CASE("PriorityBuckets", "[sched]") {
+  using buckets_t = sgp::cpu::sched::PriorityBuckets;
+  buckets_t buckets(16, 8);
+  REQUIRE(buckets.GetNumLevels() == 8);
+  REQUIRE(buckets.empty());
+  buckets.Push(4, 2);
+  buckets.Push(9, 7);
+  buckets.Push(1, 2);
+  buckets.Push(3, 0);
+  buckets.Push(5, 7);
+  REQUIRE(buckets.size() == 5);
+  REQUIRE(buckets.GetMaxLevel() == 7);
+  REQUIRE(buckets.GetMinLevel() == 0);
+  REQUIRE(buckets.GetMaxID() == 9); // Longest at the highest level.
+  REQUIRE(buckets.PopMin() == 3);
+  REQUIRE(buckets.GetMinID() == 1); // Most recent arrival at the lowest level.
+  buckets.Update(1, 7);
+  REQUIRE(buckets.GetMinID() == 4);
+  REQUIRE(buckets.GetLevel(1) == 7);
+  REQUIRE(buckets.PopMax() == 9);
+  REQUIRE(buckets.PopMax() == 5);
+  REQUIRE(buckets.PopMax() == 1);
+  REQUIRE(buckets.PopMax() == 4);
+  REQUIRE(buckets.empty());
+  buckets.Push(15, 3);
+  buckets.Resize(8);
+  REQUIRE(buckets.empty());
+
+  // Randomized comparison against a brute-force search.
+  emp::Random random(1);
+  buckets.SetNumLevels(buckets_t::MAX_LEVELS);
+  buckets.Resize(64);
+  emp::vector<size_t> levels(64, buckets_t::npos);
+  emp::vector<size_t> arrival(64, 0);
+  for (size_t i = 0; i < 10000; ++i) {
+    const size_t id = random.GetUInt(64);
+    if (buckets.Has(id)) {
+      buckets.Remove(id);
+      levels[id] = buckets_t::npos;
+    } else {
+      const size_t level = random.GetUInt(buckets_t::MAX_LEVELS);
+      buckets.Push(id, level);
+      levels[id] = level;
+      arrival[id] = i;
+    }
+    size_t max_id = buckets_t::npos;
+    size_t min_id = buckets_t::npos;
+    for (size_t j = 0; j < levels.size(); ++j) {
+      if (levels[j] == buckets_t::npos) continue;
+      if (max_id == buckets_t::npos || levels[j] > levels[max_id]
+          || (levels[j] == levels[max_id] && arrival[j] < arrival[max_id])) max_id = j;
+      if (min_id == buckets_t::npos || levels[j] < levels[min_id]
+          || (levels[j] == levels[min_id] && arrival[j] > arrival[min_id])) min_id = j;
+    }
+    if (max_id == buckets_t::npos) {
+      REQUIRE(buckets.empty());
+    } else {
+      REQUIRE(buckets.GetMaxID() == max_id);
+      REQUIRE(buckets.GetMinID() == min_id);
+    }
+  }
+}
+
+TEST_CASE("ThreadTable", "[sched]") {
+  struct ExecState {
+    int value=0;
+    void Reset() { value = 0; }
+  };
+  using table_t = sgp::cpu::sched::ThreadTable<ExecState>;
+  using thread_state_t = sgp::cpu::sched::ThreadState;
+  table_t table(4);
+  REQUIRE(table.size() == 4);
+  for (size_t id = 0; id < table.size(); ++id) {
+    REQUIRE(table[id].IsDead());
+    REQUIRE(table[id].GetPriority() == 1.0);
+    REQUIRE(!table[id].IsInitDeferred());
+  }
+  // Handles read and write through to the table.
+  auto thread = table[2];
+  thread.SetPending();
+  table.SetPriority(2, 3.5);
+  thread.GetExecState().value = 7;
+  table.DeferInit(2, 5);
+  table.SetSpawnStep(2, 11);
+  table.AddExecSteps(2, 1);
+  table.SetFirstExecStep(2, 12);
+  table.AddVirtualRuntime(2, 0.5);
+  REQUIRE(table.GetRunState(2) == thread_state_t::PENDING);
+  REQUIRE(table.GetPriority(2) == 3.5);
+  REQUIRE(thread.GetPriority() == 3.5);
+  REQUIRE(table.GetExecState(2).value == 7);
+  REQUIRE(thread.IsInitDeferred());
+  REQUIRE(table.GetInitModule(2) == 5);
+  REQUIRE(thread.GetSpawnStep() == 11);
+  REQUIRE(thread.GetNumExecSteps() == 1);
+  REQUIRE(thread.GetFirstExecStep() == 12);
+  REQUIRE(thread.GetVirtualRuntime() == 0.5);
+  // Handles stay valid when the table grows.
+  table.Resize(64);
+  REQUIRE(thread.IsPending());
+  REQUIRE(thread.GetExecState().value == 7);
+  REQUIRE(table[63].IsDead());
+  // Reset returns a thread to its default state.
+  thread.Reset();
+  REQUIRE(thread.IsDead());
+  REQUIRE(thread.GetPriority() == 1.0);
+  REQUIRE(!thread.IsInitDeferred());
+  REQUIRE(thread.GetNumExecSteps() == 0);
+  REQUIRE(thread.GetFirstExecStep() == table_t::npos);
+  REQUIRE(thread.GetVirtualRuntime() == 0.0);
+  REQUIRE(thread.GetExecState().value == 0);
+}
+
+TEST_CASE("ThreadMembership", "[sched]") {
+  using sgp::cpu::sched::Membership;
+  auto check_membership = [](auto& tags) {
+    using tags_t = std::decay_t<decltype(tags)>;
+    tags.Reset(4, Membership::UNUSED);
+    REQUIRE(tags.Check(3, Membership::UNUSED));
+    tags.Set(3, Membership::PENDING);
+    tags.Resize(6);
+    REQUIRE(tags.Check(3, Membership::PENDING));
+    REQUIRE(tags.Check(5, Membership::NONE));
+    if constexpr (tags_t::ENABLED) {
+      // Checks are exact when tracking is enabled (debug builds).
+      REQUIRE(!tags.Check(3, Membership::UNUSED));
+      REQUIRE(!tags.Check(6, Membership::NONE));
+      tags.Resize(3);
+      REQUIRE(!tags.Check(3, Membership::PENDING));
+    } else {
+      REQUIRE(tags.Check(3, Membership::UNUSED));
+    }
+  };
+  sgp::cpu::sched::ThreadMembership<> dynamic_tags;
+  sgp::cpu::sched::ThreadMembership<8> fixed_tags;
+  check_membership(dynamic_tags);
+  check_membership(fixed_tags);
+}
+
+TEST_CASE("CycleDetector", "[sched]") {
+  sgp::cpu::sched::CycleDetector detector;
+  // Sequence with a tail of length 5, then a cycle of length 7.
+  auto state = [](size_t i) { return i < 5 ? 100 + i : (i - 5) % 7; };
+  size_t num_observed = 0;
+  while (!detector.Observe(state(num_observed))) {
+    ++num_observed;
+    REQUIRE(num_observed < 100);
+  }
+  REQUIRE(detector.IsCycleDetected());
+  REQUIRE(detector.GetCycleLength() == 7);
+  REQUIRE(num_observed <= 2 * 7 + 5 + 7);
+  REQUIRE(detector.Observe(12345));
+  detector.Reset();
+  REQUIRE(!detector.IsCycleDetected());
+  // Sequences that never repeat are never flagged.
+  for (size_t i = 0; i < 1000; ++i) REQUIRE(!detector.Observe(i));
+  // Fixed points are cycles of length 1.
+  detector.Reset();
+  REQUIRE(!detector.Observe(3));
+  REQUIRE(detector.Observe(3));
+  REQUIRE(detector.GetCycleLength() == 1);
+}
@@ -1,6 +1,8 @@
 #define CATCH_CONFIG_MAIN
 #include "catch2/catch.hpp"
 
+#include <cstdlib>
+#include <new>
 #include <utility>
 #include <iostream>
 #include <string>
@@ -10,6 +12,18 @@
 
 #include "sgp/cpu/ToyCPU.hpp"
 
+// Count global heap allocations (used to check that steady-state thread management does not allocate).
+static size_t num_allocations = 0;
+
+void* operator new(size_t size) {
+  ++num_allocations;
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
 TEST_CASE("Toy SignalGP", "[general]") {
   using signalgp_t = sgp::cpu::ToyCPU<size_t>;
   using event_lib_t = typename signalgp_t::event_lib_t;
@@ -73,8 +87,8 @@ TEST_CASE("Thread Management (Toy SignalGP)") {
   REQUIRE(hardware.ValidateThreadState());
   hardware.SetThreadCapacity(16);
   REQUIRE(hardware.ValidateThreadState());
-  REQUIRE(hardware.GetThreads().size() >= 8);
-  REQUIRE(hardware.GetThreads().size() <= 16);
+  REQUIRE(hardware.ViewThreads().size() >= 8);
+  REQUIRE(hardware.ViewThreads().size() <= 16);
 
   // Make a toy program.
   emp::vector<size_t> prog1({1, 5, 10, 20, 50, 100});
@@ -260,4 +274,800 @@ TEST_CASE("Thread Management (Toy SignalGP)") {
   REQUIRE(hardware.GetActiveThreadIDs().size() == 0);
   REQUIRE(hardware.GetPendingThreadIDs().size() == 0);
   REQUIRE(hardware.GetThreadExecOrder().size() == 0);
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Test - re-prioritize pending and active threads
+  std::cout << "Test - Re-prioritize pending and active threads" << std::endl;
+  hardware.ResetHardware();
+  for (size_t i = 0; i < 8; ++i) hardware.SpawnThreadWithID(3, 1);
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 8);
+  auto low_id = hardware.SpawnThreadWithID(3, 0.5);
+  auto high_id = hardware.SpawnThreadWithID(3, 0.5);
+  REQUIRE(low_id);
+  REQUIRE(high_id);
+  hardware.SetThreadPriority(high_id.value(), 2);
+  REQUIRE(hardware.ValidateThreadState());
+  hardware.SingleProcess();
+  REQUIRE(hardware.ValidateThreadState());
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 8);
+  REQUIRE(hardware.GetThread(high_id.value()).IsRunning());
+  REQUIRE(hardware.GetThread(low_id.value()).IsDead());
+  // Lower the priority of an active thread; it should be the one replaced.
+  const size_t victim_id = *hardware.GetActiveThreadIDs().begin();
+  REQUIRE(victim_id != high_id.value());
+  hardware.SetThreadPriority(victim_id, 0);
+  REQUIRE(hardware.ValidateThreadState());
+  auto new_id = hardware.SpawnThreadWithID(3, 0.5);
+  REQUIRE(new_id);
+  hardware.SingleProcess();
+  REQUIRE(hardware.ValidateThreadState());
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 8);
+  REQUIRE(hardware.GetThread(new_id.value()).IsRunning());
+  REQUIRE(!hardware.GetActiveThreadIDs().Has(victim_id));
+  REQUIRE(hardware.GetThread(victim_id).IsDead());
+}
+
+TEST_CASE("Thread quantum (Toy SignalGP)") {
+  using signalgp_t = sgp::cpu::ToyCPU<size_t>;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+
+  event_lib_t event_lib;
+  signalgp_t hardware(event_lib);
+  hardware.SetProgram({10, 3});
+  REQUIRE(hardware.GetThreadQuantum() == 1);
+  hardware.SetThreadQuantum(4);
+  auto long_id = hardware.SpawnThreadWithID(0);
+  auto short_id = hardware.SpawnThreadWithID(1);
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetThread(long_id.value()).GetExecState().value == 6);
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 1); // Short thread finished (early) in its quantum.
+  REQUIRE(hardware.GetThread(short_id.value()).IsDead());
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetThread(long_id.value()).GetExecState().value == 2);
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 0);
+  REQUIRE(hardware.ValidateThreadState());
+}
+
+TEST_CASE("Process until idle (Toy SignalGP)") {
+  using signalgp_t = sgp::cpu::ToyCPU<size_t>;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+
+  event_lib_t event_lib;
+  signalgp_t hardware(event_lib);
+  hardware.SetProgram({10, 3});
+  REQUIRE(hardware.IsIdle());
+  REQUIRE(hardware.ProcessUntilIdle(100) == 0);
+  hardware.SpawnThreadWithID(0);
+  hardware.SpawnThreadWithID(1);
+  REQUIRE(!hardware.IsIdle());
+  REQUIRE(hardware.ProcessUntilIdle(4) == 4); // Step cap reached first.
+  REQUIRE(!hardware.IsIdle());
+  REQUIRE(hardware.ProcessUntilIdle(100) == 7); // 10 decrements + 1 step to die.
+  REQUIRE(hardware.IsIdle());
+  REQUIRE(hardware.ValidateThreadState());
+}
+
+TEST_CASE("Spawn admission control (Toy SignalGP)") {
+  using signalgp_t = sgp::cpu::ToyCPU<size_t>;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+  using spawn_status_t = typename signalgp_t::spawn_status_t;
+
+  event_lib_t event_lib;
+  signalgp_t hardware(event_lib);
+  hardware.SetActiveThreadLimit(4);
+  hardware.SetThreadCapacity(8);
+  hardware.SetProgram({100, 100, 100});
+
+  // Fill thread space with pending threads; without admission control, extra spawns are only
+  // rejected when there is no space.
+  for (size_t i = 0; i < 8; ++i) {
+    REQUIRE(hardware.SpawnThreadWithID(0, 1).GetStatus() == spawn_status_t::SPAWNED);
+  }
+  REQUIRE(hardware.SpawnThreadWithID(0, 1).GetStatus() == spawn_status_t::REJECTED_NO_SPACE);
+  REQUIRE(!hardware.SpawnThreadWithID(0, 0.5));
+  auto replaced = hardware.SpawnThreadWithID(0, 2);
+  REQUIRE(replaced.GetStatus() == spawn_status_t::REPLACED_PENDING);
+  REQUIRE(hardware.GetPendingThreadIDs().size() == 8);
+  hardware.SingleProcess();
+  REQUIRE(hardware.ValidateThreadState());
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 4);
+  REQUIRE(hardware.GetThread(replaced.value()).IsRunning());
+
+  // With admission control, threads that cannot displace an active thread are rejected up front.
+  hardware.SetSpawnAdmissionControlUse(true);
+  REQUIRE(!hardware.IsSpawnAdmissible(0.5));
+  REQUIRE(!hardware.IsSpawnAdmissible(1));
+  REQUIRE(hardware.IsSpawnAdmissible(1.5));
+  const size_t num_unused = hardware.GetNumUnusedThreads();
+  auto rejected = hardware.SpawnThreadWithID(0, 1);
+  REQUIRE(rejected.GetStatus() == spawn_status_t::REJECTED_PRIORITY);
+  REQUIRE(rejected.IsRejected());
+  REQUIRE(hardware.GetNumUnusedThreads() == num_unused);
+  REQUIRE(hardware.GetPendingThreadIDs().size() == 0);
+  auto admitted = hardware.SpawnThreadWithID(0, 1.5);
+  REQUIRE(admitted.GetStatus() == spawn_status_t::SPAWNED);
+  emp::vector<typename signalgp_t::spawn_result_t> results;
+  REQUIRE(hardware.SpawnThreads(0, 3, 1, results).size() == 0);
+  REQUIRE(results.size() == 3);
+  for (const auto& result : results) REQUIRE(result.GetStatus() == spawn_status_t::REJECTED_PRIORITY);
+  hardware.SingleProcess();
+  REQUIRE(hardware.ValidateThreadState());
+  REQUIRE(hardware.GetThread(admitted.value()).IsRunning());
+
+  // Without thread priority, any spawn while active slots are claimed is rejected (for lack of
+  // space, not priority).
+  hardware.SetThreadPriorityUse(false);
+  REQUIRE(!hardware.IsSpawnAdmissible(100));
+  REQUIRE(hardware.SpawnThreadWithID(0, 100).GetStatus() == spawn_status_t::REJECTED_NO_SPACE);
+  hardware.ResetHardware();
+  for (size_t i = 0; i < 4; ++i) REQUIRE(hardware.SpawnThreadWithID(0));
+  REQUIRE(hardware.SpawnThreadWithID(0).GetStatus() == spawn_status_t::REJECTED_NO_SPACE);
+  REQUIRE(hardware.ValidateThreadState());
+}
+
+TEST_CASE("Blocked threads (Toy SignalGP)") {
+  using signalgp_t = sgp::cpu::ToyCPU<size_t>;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+  using event_t = typename signalgp_t::event_t;
+  using spawn_status_t = typename signalgp_t::spawn_status_t;
+
+  event_lib_t event_lib;
+  const size_t msg_id = event_lib.AddEvent("Message", [](signalgp_t&, const event_t&) { ; });
+  signalgp_t hardware(event_lib);
+  hardware.SetActiveThreadLimit(2);
+  hardware.SetProgram({100, 100, 100});
+
+  const size_t blocked_id = hardware.SpawnThreadWithID(0).value();
+  const size_t other_id = hardware.SpawnThreadWithID(1).value();
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 2);
+  REQUIRE(!hardware.BlockThread(hardware.GetUnusedThreadIDs().back(), msg_id)); // Not running.
+  REQUIRE(hardware.BlockThread(blocked_id, msg_id));
+  REQUIRE(hardware.GetThread(blocked_id).IsBlocked());
+  REQUIRE(hardware.GetNumBlockedThreads() == 1);
+  REQUIRE(hardware.ValidateThreadState());
+
+  // Blocked threads are parked: they do not execute and they free their active slot.
+  hardware.SingleProcess();
+  REQUIRE(hardware.ValidateThreadState());
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 1);
+  REQUIRE(hardware.GetThreadExecOrder().size() == 1);
+  REQUIRE(hardware.GetThread(blocked_id).GetExecState().value == 99);
+  const size_t third_id = hardware.SpawnThreadWithID(2).value();
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetThread(third_id).IsRunning());
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 2);
+  REQUIRE(hardware.GetThread(blocked_id).GetExecState().value == 99);
+
+  // A hardware unit with only blocked threads is idle.
+  hardware.KillActiveThread(other_id);
+  hardware.KillActiveThread(third_id);
+  REQUIRE(hardware.IsIdle());
+  REQUIRE(hardware.ProcessUntilIdle(10) == 0);
+  REQUIRE(hardware.ValidateThreadState());
+
+  // Events wake threads blocked on the event's id; woken threads resume where they left off.
+  REQUIRE(hardware.WakeThreads(msg_id + 1) == 0);
+  hardware.QueueEvent(event_t(msg_id));
+  hardware.SingleProcess();
+  REQUIRE(hardware.ValidateThreadState());
+  REQUIRE(hardware.GetNumBlockedThreads() == 0);
+  REQUIRE(hardware.GetThread(blocked_id).IsRunning());
+  REQUIRE(hardware.GetThread(blocked_id).GetExecState().value == 98);
+
+  // Blocking then waking a thread before it is parked simply resumes it.
+  REQUIRE(hardware.BlockThread(blocked_id, 42));
+  REQUIRE(hardware.WakeThread(blocked_id));
+  REQUIRE(!hardware.WakeThread(blocked_id));
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetThread(blocked_id).GetExecState().value == 97);
+
+  // Blocked threads can be killed.
+  REQUIRE(hardware.BlockThread(blocked_id, 42));
+  hardware.SingleProcess();
+  REQUIRE(!hardware.KillActiveThread(blocked_id));
+  REQUIRE(hardware.KillBlockedThread(blocked_id));
+  REQUIRE(hardware.GetThread(blocked_id).IsDead());
+  REQUIRE(hardware.GetNumBlockedThreads() == 0);
+  REQUIRE(hardware.ValidateThreadState());
+
+  // Woken threads take precedence over new spawns: a thread woken while the active set is full
+  // stays parked (it is neither killed nor replaced by a spawn) until a slot frees up.
+  hardware.ResetHardware();
+  hardware.SetThreadCapacity(4);
+  const size_t woken_id = hardware.SpawnThreadWithID(0).value();
+  hardware.SingleProcess();
+  REQUIRE(hardware.BlockThread(woken_id, msg_id));
+  hardware.SingleProcess();
+  const size_t first_id = hardware.SpawnThreadWithID(1).value();
+  const size_t second_id = hardware.SpawnThreadWithID(2).value();
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 2);
+  REQUIRE(hardware.WakeThread(woken_id));
+  REQUIRE(hardware.GetNumWokenThreads() == 1);
+  REQUIRE(hardware.GetNumPendingThreads() == 0);
+  REQUIRE(!hardware.IsSpawnAdmissible(100));
+  const size_t spawned_id = hardware.SpawnThreadWithID(0, 1).value();
+  // No thread space left: a spawn may only replace a pending thread, never a woken one.
+  auto replaced = hardware.SpawnThreadWithID(0, 2);
+  REQUIRE(replaced.GetStatus() == spawn_status_t::REPLACED_PENDING);
+  REQUIRE(replaced.value() == spawned_id);
+  REQUIRE(hardware.ValidateThreadState());
+  hardware.SingleProcess();
+  REQUIRE(hardware.ValidateThreadState());
+  REQUIRE(hardware.GetThread(spawned_id).IsDead()); // Not activated while a woken thread waits.
+  REQUIRE(hardware.GetThread(woken_id).IsPending());
+  REQUIRE(hardware.GetThread(woken_id).GetExecState().value == 99);
+  REQUIRE(hardware.GetNumWokenThreads() == 1);
+  REQUIRE(hardware.GetThread(first_id).IsRunning());
+  REQUIRE(hardware.GetThread(second_id).IsRunning());
+  // Once a slot frees up, the woken thread resumes where it left off.
+  REQUIRE(hardware.KillActiveThread(first_id));
+  hardware.SingleProcess();
+  REQUIRE(hardware.ValidateThreadState());
+  REQUIRE(hardware.GetNumWokenThreads() == 0);
+  REQUIRE(hardware.GetThread(woken_id).IsRunning());
+  REQUIRE(hardware.GetThread(woken_id).GetExecState().value == 98);
+}
+
+TEST_CASE("Delayed events (Toy SignalGP)") {
+  using signalgp_t = sgp::cpu::ToyCPU<size_t>;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+  using event_t = typename signalgp_t::event_t;
+
+  event_lib_t event_lib;
+  const size_t spawn_id = event_lib.AddEvent(
+    "Spawn",
+    [](signalgp_t& hw, const event_t&) { hw.SpawnThreadWithID(0); }
+  );
+  signalgp_t hardware(event_lib);
+  hardware.SetProgram({1});
+  REQUIRE(hardware.GetNumSteps() == 0);
+
+  hardware.QueueEventIn(event_t(spawn_id), 0); // Next step.
+  hardware.QueueEventIn(event_t(spawn_id), 2);
+  hardware.QueueEventAt(event_t(spawn_id), 1000);
+  REQUIRE(hardware.GetNumScheduledEvents() == 3);
+  REQUIRE(!hardware.IsIdle());
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetNumSteps() == 1);
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 1);
+  hardware.SingleProcess(); // Thread dies.
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 0);
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 1);
+  REQUIRE(hardware.GetNumScheduledEvents() == 1);
+  // Hardware is not idle until all scheduled events have been handled.
+  REQUIRE(hardware.ProcessUntilIdle(2000) == 999);
+  REQUIRE(hardware.GetNumSteps() == 1002);
+  REQUIRE(hardware.GetNumScheduledEvents() == 0);
+
+  hardware.QueueEventIn(event_t(spawn_id), 10);
+  hardware.ResetHardware();
+  REQUIRE(hardware.GetNumScheduledEvents() == 0);
+  REQUIRE(hardware.GetNumSteps() == 0);
+}
+
+TEST_CASE("Priority-bucket scheduling (Toy SignalGP)") {
+  using signalgp_t = sgp::cpu::ToyCPU<size_t>;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+
+  event_lib_t event_lib;
+  emp::Random random(2);
+  signalgp_t hardware(event_lib);
+  hardware.SetActiveThreadLimit(2);
+  hardware.SetThreadCapacity(4);
+  hardware.SetProgram({100, 100});
+  const size_t low_id = hardware.SpawnThreadWithID(0, 1.0).value();
+  hardware.SingleProcess();
+
+  // Switching modes re-indexes existing threads.
+  REQUIRE(hardware.GetNumPriorityLevels() == 0);
+  hardware.SetNumPriorityLevels(4);
+  REQUIRE(hardware.GetNumPriorityLevels() == 4);
+  REQUIRE(hardware.ValidateThreadState());
+  REQUIRE(hardware.GetPriorityLevel(-1.0) == 0);
+  REQUIRE(hardware.GetPriorityLevel(2.7) == 2);
+  REQUIRE(hardware.GetPriorityLevel(100.0) == 3);
+
+  // Priorities are compared by level.
+  const size_t mid_id = hardware.SpawnThreadWithID(0, 2.0).value();
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetActiveThreadIDs().size() == 2);
+  const size_t same_level_id = hardware.SpawnThreadWithID(0, 1.9).value(); // Level 1: can't displace.
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetThread(same_level_id).IsDead());
+  REQUIRE(hardware.GetThread(low_id).IsRunning());
+  const size_t high_id = hardware.SpawnThreadWithID(0, 3.0).value();
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetThread(high_id).IsRunning());
+  REQUIRE(hardware.GetThread(mid_id).IsRunning());
+  REQUIRE(hardware.GetThread(low_id).IsDead());
+  REQUIRE(hardware.ValidateThreadState());
+
+  // Spawn storm with integer priorities.
+  hardware.SetActiveThreadLimit(8);
+  hardware.SetThreadCapacity(16);
+  for (size_t step = 0; step < 200; ++step) {
+    for (size_t i = 0; i < 12; ++i) {
+      hardware.SpawnThreadWithID(random.GetUInt(2), (double)random.GetUInt(4));
+    }
+    if (random.P(0.1)) {
+      const size_t id = random.GetUInt(hardware.ViewThreads().size());
+      hardware.SetThreadPriority(id, (double)random.GetUInt(4));
+    }
+    hardware.SingleProcess();
+    REQUIRE(hardware.ValidateThreadState());
+  }
+  hardware.SetNumPriorityLevels(0);
+  REQUIRE(hardware.ValidateThreadState());
+}
+
+TEST_CASE("Thread metadata (Toy SignalGP)") {
+  using signalgp_t = sgp::cpu::ToyCPU<size_t>;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+
+  event_lib_t event_lib;
+  signalgp_t hardware(event_lib);
+  hardware.SetProgram({5, 2});
+  hardware.Process(3);
+  const size_t thread_id = hardware.SpawnThreadWithID(0, 2.0).value();
+  REQUIRE(hardware.GetThread(thread_id).GetSpawnStep() == 3);
+  REQUIRE(hardware.GetThread(thread_id).GetNumExecSteps() == 0);
+  hardware.SetThreadQuantum(2);
+  hardware.Process(2);
+  REQUIRE(hardware.GetThread(thread_id).GetNumExecSteps() == 4);
+  REQUIRE(hardware.GetThread(thread_id).GetPriority() == 2.0);
+  REQUIRE(hardware.GetThread(thread_id).GetExecState().value == 1);
+  REQUIRE(hardware.ValidateThreadState());
+}
+
+TEST_CASE("Fair-share scheduling (Toy SignalGP)") {
+  using signalgp_t = sgp::cpu::ToyCPU<size_t>;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+  using event_t = typename signalgp_t::event_t;
+
+  event_lib_t event_lib;
+  const size_t urgent_id = event_lib.AddEvent(
+    "Urgent",
+    [](signalgp_t& hw, const event_t&) { hw.SpawnThreadWithID(0, 0.1); }
+  );
+  signalgp_t hardware(event_lib);
+  hardware.SetProgram({100000});
+  hardware.SetFairShareScheduling();
+  REQUIRE(hardware.IsFairShareSchedulingUsed());
+
+  // Execution steps are shared in proportion to priority.
+  const size_t low_id = hardware.SpawnThreadWithID(0, 1.0).value();
+  const size_t high_id = hardware.SpawnThreadWithID(0, 4.0).value();
+  const size_t slow_id = hardware.SpawnThreadWithID(0, 0.25).value();
+  hardware.Process(100);
+  REQUIRE(hardware.GetThread(low_id).GetNumExecSteps() == 100);
+  REQUIRE(hardware.GetThread(high_id).GetNumExecSteps() == 400);
+  REQUIRE(hardware.GetThread(slow_id).GetNumExecSteps() == 25);
+  REQUIRE(hardware.GetThread(low_id).GetVirtualRuntime() == Approx(100.0));
+  REQUIRE(hardware.GetThread(high_id).GetVirtualRuntime() == Approx(100.0));
+  REQUIRE(hardware.GetThread(slow_id).GetVirtualRuntime() == Approx(100.0));
+  REQUIRE(hardware.GetMaxSpawnLatency() == 1);
+
+  // A thread spawned by an event executes immediately, even with a tiny share.
+  hardware.QueueEvent(event_t(urgent_id));
+  hardware.SingleProcess();
+  size_t urgent_thread = hardware.GetThreadExecOrder().back();
+  REQUIRE(hardware.GetThread(urgent_thread).GetPriority() == 0.1);
+  REQUIRE(hardware.GetThread(urgent_thread).GetNumExecSteps() == 1);
+  REQUIRE(hardware.GetThread(urgent_thread).GetFirstExecStep() == hardware.GetThread(urgent_thread).GetSpawnStep());
+  // ... and then makes progress at its fair share (it must repay its first step).
+  hardware.Process(20);
+  REQUIRE(hardware.GetThread(urgent_thread).GetNumExecSteps() == 2);
+  REQUIRE(hardware.GetMaxSpawnLatency() == 1);
+
+  // Per-step execution is capped.
+  hardware.SetFairShareMaxQuantum(2);
+  const size_t before = hardware.GetThread(high_id).GetNumExecSteps();
+  hardware.Process(10);
+  REQUIRE(hardware.GetThread(high_id).GetNumExecSteps() == before + 20);
+  REQUIRE(hardware.ValidateThreadState());
+
+  hardware.ResetHardware();
+  REQUIRE(hardware.GetMaxSpawnLatency() == 0);
+}
+
+TEST_CASE("Execution states have stable addresses (Toy SignalGP)") {
+  using signalgp_t = sgp::cpu::ToyCPU<size_t>;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+
+  event_lib_t event_lib;
+  signalgp_t hardware(event_lib);
+  hardware.SetActiveThreadLimit(4);
+  hardware.SetThreadCapacity(1024);
+  hardware.SetProgram({1000});
+  const size_t thread_id = hardware.SpawnThreadWithID(0).value();
+  hardware.SingleProcess();
+  const auto* exec_state = &hardware.GetThread(thread_id).GetExecState();
+  // Grow thread storage well past its initial size.
+  const size_t initial_size = hardware.ViewThreads().size();
+  while (hardware.ViewThreads().size() < 1024) hardware.SpawnThreadWithID(0, 0.0);
+  REQUIRE(hardware.ViewThreads().size() > initial_size);
+  REQUIRE(&hardware.GetThread(thread_id).GetExecState() == exec_state);
+  REQUIRE(exec_state->value == 999);
+  hardware.SingleProcess();
+  REQUIRE(exec_state->value == 998);
+  REQUIRE(hardware.ValidateThreadState());
+}
+
+TEST_CASE("Steady-state thread management does not allocate (Toy SignalGP)") {
+  using signalgp_t = sgp::cpu::ToyCPU<size_t>;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+
+  event_lib_t event_lib;
+  emp::Random random(2);
+  signalgp_t hardware(event_lib);
+  hardware.SetActiveThreadLimit(8);
+  hardware.SetThreadCapacity(16);
+  hardware.SetProgram({1, 2, 3, 5, 8, 13});
+
+  // Spawn storm: more spawn requests than there is thread space, at a mix of priorities.
+  auto step = [&hardware, &random]() {
+    for (size_t i = 0; i < 12; ++i) {
+      hardware.SpawnThreadWithID(random.GetUInt(6), random.GetDouble(-1.0, 1.0));
+    }
+    hardware.SingleProcess();
+  };
+
+  // Warm up (let all thread management storage reach its working capacity).
+  for (size_t i = 0; i < 100; ++i) step();
+  REQUIRE(hardware.ValidateThreadState());
+  const size_t allocs_before = num_allocations;
+  for (size_t i = 0; i < 1000; ++i) step();
+  const size_t allocs_after = num_allocations;
+  REQUIRE(hardware.ValidateThreadState());
+  REQUIRE(allocs_after == allocs_before);
+}
+
+TEST_CASE("Spawning by tag does not allocate (Toy SignalGP)") {
+  using signalgp_t = sgp::cpu::ToyCPU<size_t>;
+  using event_lib_t = typename signalgp_t::event_lib_t;
+
+  event_lib_t event_lib;
+  emp::Random random(3);
+  signalgp_t hardware(event_lib);
+  hardware.SetActiveThreadLimit(8);
+  hardware.SetThreadCapacity(16);
+  hardware.SetProgram({1, 2, 3, 5, 8, 13});
+
+  // Caller-provided buffers match the allocating versions.
+  emp::vector<size_t> matches;
+  hardware.FindModuleMatches(4, 3, matches);
+  REQUIRE(matches == hardware.FindModuleMatch(4, 3));
+  REQUIRE(hardware.FindBestModuleMatch(7).value() == 1);
+  emp::vector<size_t> thread_ids;
+  hardware.SpawnThreads(2, 3, 1.0, thread_ids);
+  REQUIRE(thread_ids.size() == 3);
+  REQUIRE(hardware.GetNumPendingThreads() == 3);
+
+  auto step = [&hardware, &random, &thread_ids]() {
+    for (size_t i = 0; i < 4; ++i) {
+      hardware.SpawnThreadWithTag(random.GetUInt(100), random.GetDouble(-1.0, 1.0));
+      hardware.SpawnThreads(random.GetUInt(100), 2, random.GetDouble(-1.0, 1.0), thread_ids);
+    }
+    hardware.SingleProcess();
+  };
+
+  // Warm up (let thread storage and buffers reach their working capacity).
+  for (size_t i = 0; i < 100; ++i) step();
+  const size_t allocs_before = num_allocations;
+  for (size_t i = 0; i < 1000; ++i) step();
+  REQUIRE(num_allocations == allocs_before);
+  REQUIRE(hardware.ValidateThreadState());
+
+  // Without a program, nothing matches.
+  hardware.ResetProgram();
+  REQUIRE(!hardware.FindBestModuleMatch(7));
+  REQUIRE(hardware.SpawnThreadWithTag(7).GetStatus() == sgp::cpu::sched::SpawnStatus::REJECTED_NO_MATCH);
+}
+
+/// Run a random spawn workload on the given hardware; return a trace of (thread id, value) for
+/// each thread in the execution order after every step.
+template<typename HARDWARE_T>
+emp::vector<std::pair<size_t, size_t>> RunSchedulerWorkload(HARDWARE_T& hardware, size_t seed) {
+  emp::Random random(seed);
+  hardware.SetActiveThreadLimit(8);
+  hardware.SetThreadCapacity(16);
+  hardware.SetProgram({3, 5, 8, 13, 21});
+  emp::vector<std::pair<size_t, size_t>> trace;
+  for (size_t step = 0; step < 200; ++step) {
+    const size_t num_spawns = random.GetUInt(6);
+    for (size_t i = 0; i < num_spawns; ++i) {
+      hardware.SpawnThreadWithID(random.GetUInt(5), (double)random.GetUInt(6));
+    }
+    hardware.SingleProcess();
+    for (size_t id : hardware.GetThreadExecOrder()) {
+      trace.emplace_back(id, hardware.GetThread(id).GetExecState().value);
+    }
+    trace.emplace_back(hardware.GetNumSteps(), hardware.GetNumActiveThreads());
+  }
+  REQUIRE(hardware.ValidateThreadState());
+  return trace;
+}
+
+TEST_CASE("Scheduler policies (Toy SignalGP)") {
+  using configurable_t = sgp::cpu::ToyCPU<size_t>;
+  using fifo_t = sgp::cpu::ToyCPU<size_t, sgp::cpu::sched::FIFOScheduler>;
+  using priority_t = sgp::cpu::ToyCPU<size_t, sgp::cpu::sched::PriorityPreemptiveScheduler<>>;
+  using priority_levels_t = sgp::cpu::ToyCPU<size_t, sgp::cpu::sched::PriorityPreemptiveScheduler<4>>;
+  using round_robin_t = sgp::cpu::ToyCPU<size_t, sgp::cpu::sched::RoundRobinScheduler<3>>;
+
+  // Each policy behaves exactly like the equivalently configured default hardware.
+  for (size_t seed = 1; seed <= 4; ++seed) {
+    typename configurable_t::event_lib_t config_event_lib;
+
+    configurable_t no_priority_hw(config_event_lib);
+    no_priority_hw.SetThreadPriorityUse(false);
+    typename fifo_t::event_lib_t fifo_event_lib;
+    fifo_t fifo_hw(fifo_event_lib);
+    REQUIRE(!fifo_hw.IsThreadPriorityUsed());
+    REQUIRE(RunSchedulerWorkload(fifo_hw, seed) == RunSchedulerWorkload(no_priority_hw, seed));
+
+    configurable_t priority_config_hw(config_event_lib);
+    typename priority_t::event_lib_t priority_event_lib;
+    priority_t priority_hw(priority_event_lib);
+    REQUIRE(priority_hw.IsThreadPriorityUsed());
+    REQUIRE(RunSchedulerWorkload(priority_hw, seed) == RunSchedulerWorkload(priority_config_hw, seed));
+
+    configurable_t levels_config_hw(config_event_lib);
+    levels_config_hw.SetNumPriorityLevels(4);
+    typename priority_levels_t::event_lib_t levels_event_lib;
+    priority_levels_t levels_hw(levels_event_lib);
+    REQUIRE(levels_hw.GetNumPriorityLevels() == 4);
+    REQUIRE(RunSchedulerWorkload(levels_hw, seed) == RunSchedulerWorkload(levels_config_hw, seed));
+
+    configurable_t rr_config_hw(config_event_lib);
+    rr_config_hw.SetThreadPriorityUse(false);
+    rr_config_hw.SetThreadQuantum(3);
+    typename round_robin_t::event_lib_t rr_event_lib;
+    round_robin_t rr_hw(rr_event_lib);
+    REQUIRE(rr_hw.GetThreadQuantum() == 3);
+    REQUIRE(RunSchedulerWorkload(rr_hw, seed) == RunSchedulerWorkload(rr_config_hw, seed));
+  }
+
+  // FIFO: pending threads never preempt active threads, whatever their priority.
+  typename fifo_t::event_lib_t event_lib;
+  fifo_t hardware(event_lib);
+  hardware.SetActiveThreadLimit(2);
+  hardware.SetProgram({100});
+  hardware.SpawnThreadWithID(0, 1.0);
+  hardware.SpawnThreadWithID(0, 1.0);
+  hardware.SingleProcess();
+  const size_t urgent_id = hardware.SpawnThreadWithID(0, 10.0).value();
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetThread(urgent_id).IsDead());
+  REQUIRE(hardware.GetNumActiveThreads() == 2);
+  REQUIRE(hardware.ValidateThreadState());
+}
+
+TEST_CASE("Fixed thread capacity (Toy SignalGP)") {
+  using configurable_t = sgp::cpu::ToyCPU<size_t>;
+  using fixed_t = sgp::cpu::ToyCPU<size_t, sgp::cpu::sched::FixedCapacity<8, 16>>;
+  using fixed_fifo_t = sgp::cpu::ToyCPU<size_t, sgp::cpu::sched::FixedCapacity<8, 16, sgp::cpu::sched::FIFOScheduler>>;
+
+  // Fixed-capacity hardware behaves exactly like equivalently configured default hardware.
+  for (size_t seed = 1; seed <= 4; ++seed) {
+    typename configurable_t::event_lib_t config_event_lib;
+    configurable_t config_hw(config_event_lib);
+    typename fixed_t::event_lib_t fixed_event_lib;
+    fixed_t fixed_hw(fixed_event_lib);
+    REQUIRE(fixed_hw.GetMaxActiveThreads() == 8);
+    REQUIRE(fixed_hw.GetMaxThreadSpace() == 16);
+    REQUIRE(fixed_hw.ViewThreads().size() == 16);
+    REQUIRE(RunSchedulerWorkload(fixed_hw, seed) == RunSchedulerWorkload(config_hw, seed));
+
+    configurable_t config_fifo_hw(config_event_lib);
+    config_fifo_hw.SetThreadPriorityUse(false);
+    typename fixed_fifo_t::event_lib_t fixed_fifo_event_lib;
+    fixed_fifo_t fixed_fifo_hw(fixed_fifo_event_lib);
+    REQUIRE(RunSchedulerWorkload(fixed_fifo_hw, seed) == RunSchedulerWorkload(config_fifo_hw, seed));
+  }
+
+  // Thread bookkeeping is stored inline: constructing and running the hardware never allocates.
+  typename fixed_t::event_lib_t event_lib;
+  emp::Random random(2);
+  const size_t allocs_before = num_allocations;
+  fixed_t hardware(event_lib);
+  REQUIRE(num_allocations == allocs_before);
+  hardware.SetProgram({1, 2, 3, 5, 8, 13});
+  const size_t allocs_before_run = num_allocations;
+  for (size_t i = 0; i < 1000; ++i) {
+    for (size_t j = 0; j < 12; ++j) {
+      hardware.SpawnThreadWithID(random.GetUInt(6), random.GetDouble(-1.0, 1.0));
+    }
+    hardware.SingleProcess();
+  }
+  REQUIRE(num_allocations == allocs_before_run);
+  REQUIRE(hardware.ValidateThreadState());
+}
+
+TEST_CASE("Parallel thread execution (Toy SignalGP)") {
+  using hardware_t = sgp::cpu::ToyCPU<size_t>;
+  typename hardware_t::event_lib_t event_lib;
+
+  hardware_t hardware(event_lib);
+  REQUIRE(!hardware.IsParallelExecutionUsed());
+  hardware.SetParallelExecution(4);
+  REQUIRE(hardware.IsParallelExecutionUsed());
+  REQUIRE(hardware.GetNumParallelWorkers() == 4);
+  hardware.SetParallelExecution(1);
+  REQUIRE(!hardware.IsParallelExecutionUsed());
+
+  // Parallel execution behaves exactly like serial execution.
+  for (size_t seed = 1; seed <= 4; ++seed) {
+    hardware_t serial_hw(event_lib);
+    serial_hw.SetThreadQuantum(3);
+    hardware_t parallel_hw(event_lib);
+    parallel_hw.SetThreadQuantum(3);
+    parallel_hw.SetParallelExecution(4);
+    REQUIRE(RunSchedulerWorkload(parallel_hw, seed) == RunSchedulerWorkload(serial_hw, seed));
+
+    hardware_t fair_serial_hw(event_lib);
+    fair_serial_hw.SetFairShareScheduling(true);
+    fair_serial_hw.SetThreadQuantum(4);
+    hardware_t fair_parallel_hw(event_lib);
+    fair_parallel_hw.SetFairShareScheduling(true);
+    fair_parallel_hw.SetThreadQuantum(4);
+    fair_parallel_hw.SetParallelExecution(3);
+    REQUIRE(RunSchedulerWorkload(fair_parallel_hw, seed) == RunSchedulerWorkload(fair_serial_hw, seed));
+  }
+}
+
+TEST_CASE("Snapshot and restore (Toy SignalGP)") {
+  using hardware_t = sgp::cpu::ToyCPU<size_t>;
+  typename hardware_t::event_lib_t event_lib;
+
+  hardware_t hardware(event_lib);
+  hardware.SetThreadQuantum(2);
+  RunSchedulerWorkload(hardware, 5);  // Warm up.
+  auto snapshot = hardware.Snapshot();
+
+  // Run trials from the snapshot; return a trace of (thread id, value) after every step.
+  auto run_trial = [&hardware](size_t seed) {
+    emp::Random random(seed);
+    emp::vector<std::pair<size_t, size_t>> trace;
+    trace.reserve(4096);
+    for (size_t step = 0; step < 100; ++step) {
+      const size_t num_spawns = random.GetUInt(6);
+      for (size_t i = 0; i < num_spawns; ++i) {
+        hardware.SpawnThreadWithID(random.GetUInt(5), (double)random.GetUInt(6));
+      }
+      hardware.SingleProcess();
+      for (size_t id : hardware.GetThreadExecOrder()) {
+        trace.emplace_back(id, hardware.GetThread(id).GetExecState().value);
+      }
+      trace.emplace_back(hardware.GetNumActiveThreads(), hardware.GetNumPendingThreads());
+    }
+    REQUIRE(hardware.ValidateThreadState());
+    return trace;
+  };
+
+  const auto trace = run_trial(7);
+  hardware.Restore(snapshot);
+  REQUIRE(hardware.ValidateThreadState());
+  REQUIRE(run_trial(7) == trace);
+
+  // Restoring (once storage has grown to fit) does not allocate.
+  const size_t allocs_before = num_allocations;
+  hardware.Restore(snapshot);
+  REQUIRE(num_allocations == allocs_before);
+  REQUIRE(run_trial(7) == trace);
+
+  // Snapshots can be re-taken into existing storage.
+  run_trial(8);
+  hardware.Snapshot(snapshot);
+  const auto trace_8 = run_trial(9);
+  hardware.Restore(snapshot);
+  REQUIRE(run_trial(9) == trace_8);
+}
+
+TEST_CASE("Processing with a budget (Toy SignalGP)") {
+  using hardware_t = sgp::cpu::ToyCPU<size_t>;
+  using budget_t = sgp::cpu::sched::ProcessBudget;
+  using stop_reason_t = sgp::cpu::sched::ProcessStopReason;
+  typename hardware_t::event_lib_t event_lib;
+
+  // Idle hardware stops right away.
+  hardware_t hardware(event_lib);
+  auto result = hardware.ProcessFor(budget_t::Instructions(100));
+  REQUIRE(result.reason == stop_reason_t::IDLE);
+  REQUIRE(result.num_steps == 0);
+  REQUIRE(result.num_instructions == 0);
+
+  // Step budgets behave like Process.
+  hardware.SetThreadQuantum(2);
+  hardware.SetProgram({10, 20, 30});
+  for (size_t i = 0; i < 3; ++i) hardware.SpawnThreadWithID(i);
+  result = hardware.ProcessFor(budget_t::Steps(3));
+  REQUIRE(result.reason == stop_reason_t::STEPS);
+  REQUIRE(result.num_steps == 3);
+  REQUIRE(result.num_instructions == 3 * 3 * 2);
+  REQUIRE(hardware.GetNumInstructions() == 3 * 3 * 2);
+  REQUIRE(hardware.GetNumSteps() == 3);
+
+  // Instruction budgets pause steps between threads' turns.
+  result = hardware.ProcessFor(budget_t::Instructions(3));
+  REQUIRE(result.reason == stop_reason_t::INSTRUCTIONS);
+  REQUIRE(result.num_instructions == 4);
+  REQUIRE(result.num_steps == 0);
+  REQUIRE(result.step_in_progress);
+  REQUIRE(hardware.IsStepInProgress());
+  REQUIRE(hardware.GetNumSteps() == 4);
+  REQUIRE(hardware.ValidateThreadState());
+  // The paused step resumes with the third thread's turn.
+  const auto& thread_ids = hardware.GetThreadExecOrder();
+  REQUIRE(hardware.GetThread(thread_ids[0]).GetExecState().value == 2);
+  REQUIRE(hardware.GetThread(thread_ids[2]).GetExecState().value == 24);
+  hardware.SingleProcess();
+  REQUIRE(!hardware.IsStepInProgress());
+  REQUIRE(hardware.GetNumSteps() == 4);
+  REQUIRE(hardware.GetThread(thread_ids[2]).GetExecState().value == 22);
+
+  // Killing the thread whose turn is next in a paused step skips its turn.
+  hardware.ProcessFor(budget_t::Instructions(1));
+  REQUIRE(hardware.IsStepInProgress());
+  const size_t next_id = hardware.GetThreadExecOrder()[1];
+  hardware.KillActiveThread(next_id);
+  hardware.SingleProcess();
+  REQUIRE(hardware.GetNumActiveThreads() == 2);
+  REQUIRE(hardware.ValidateThreadState());
+
+  // Execution follows the same trajectory no matter how it is split across budgets.
+  for (size_t seed = 1; seed <= 3; ++seed) {
+    hardware_t stepped_hw(event_lib);
+    stepped_hw.SetThreadQuantum(3);
+    const auto trace = RunSchedulerWorkload(stepped_hw, seed);
+
+    hardware_t budget_hw(event_lib);
+    budget_hw.SetThreadQuantum(3);
+    emp::Random random(seed);
+    budget_hw.SetActiveThreadLimit(8);
+    budget_hw.SetThreadCapacity(16);
+    budget_hw.SetProgram({3, 5, 8, 13, 21});
+    emp::vector<std::pair<size_t, size_t>> budget_trace;
+    for (size_t step = 0; step < 200; ++step) {
+      const size_t num_spawns = random.GetUInt(6);
+      for (size_t i = 0; i < num_spawns; ++i) {
+        budget_hw.SpawnThreadWithID(random.GetUInt(5), (double)random.GetUInt(6));
+      }
+      // Take exactly one step, in slices of (about) 4 instructions.
+      budget_t budget = budget_t::Instructions(4);
+      budget.max_steps = 1;
+      const size_t num_steps = budget_hw.GetNumSteps();
+      do {
+        const size_t num_instructions = budget_hw.GetNumInstructions();
+        result = budget_hw.ProcessFor(budget);
+        REQUIRE(result.num_instructions == budget_hw.GetNumInstructions() - num_instructions);
+        REQUIRE(result.num_instructions < 4 + 3);
+        if (result.reason == stop_reason_t::IDLE) budget_hw.SingleProcess();
+      } while (budget_hw.IsStepInProgress());
+      REQUIRE(budget_hw.GetNumSteps() == num_steps + 1);
+      for (size_t id : budget_hw.GetThreadExecOrder()) {
+        budget_trace.emplace_back(id, budget_hw.GetThread(id).GetExecState().value);
+      }
+      budget_trace.emplace_back(budget_hw.GetNumSteps(), budget_hw.GetNumActiveThreads());
+    }
+    REQUIRE(budget_trace == trace);
+  }
+
+  // Wall-clock budgets.
+  hardware.SetProgram({1000000});
+  hardware.SpawnThreadWithID(0);
+  result = hardware.ProcessFor(budget_t::Until(budget_t::wall_clock_t::now()));
+  REQUIRE(result.reason == stop_reason_t::DEADLINE);
+  REQUIRE(result.num_instructions == 0);
+  const auto deadline = budget_t::wall_clock_t::now() + std::chrono::milliseconds(2);
+  result = hardware.ProcessFor(budget_t::Until(deadline, 16));
+  REQUIRE(result.reason == stop_reason_t::DEADLINE);
+  REQUIRE(budget_t::wall_clock_t::now() >= deadline);
+  REQUIRE(result.elapsed > budget_t::wall_clock_t::duration::zero());
+  REQUIRE(result.num_instructions > 0);
 }